@@ -0,0 +1,61 @@
+/*
+ * @file log_limit.h
+ * @author Dhruv Mamtora
+ * @version 0.1.0
+ * @date 18 October, 2026
+ *
+ * @brief Per-module rate limit for log messages.
+ *
+ * @details
+ * Each module that logs from a loop defines one limiter with LOG_LIMIT_DEFINE() and logs
+ * through LOG_LIMITED(), e.g. LOG_LIMITED(LOG_DBG, mainLimit, "LED %s", "ON"). A module may
+ * log up to CONFIG_RATE_LIMITED_LOG_RATE messages per second with bursts of
+ * CONFIG_RATE_LIMITED_LOG_BURST; messages above that are counted instead of being queued. The
+ * first message let through after a suppression is preceded by a warning with the count, so
+ * nothing is lost silently. Messages the deferred log buffer had no room for are reported by
+ * the log thread itself ("--- N messages dropped ---").
+ *
+ * With CONFIG_RATE_LIMITED_LOG=n LOG_LIMITED() is the plain log macro.
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef LOG_LIMIT_H
+#define LOG_LIMIT_H
+
+/** REQUIRED HEADER FILES */
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+#ifdef CONFIG_RATE_LIMITED_LOG
+
+typedef struct {
+	struct k_spinlock lock;
+	int64_t iNextTicks; /* Earliest time the bucket is empty again (GCRA) */
+	uint32_t iSkipped;  /* Suppressed since the last message let through */
+} logLimit_t;
+
+#define LOG_LIMIT_DEFINE(_name) static logLimit_t _name
+
+#define LOG_LIMITED(_log, _limit, ...)                                                             \
+	do {                                                                                       \
+		uint32_t _iSkipped;                                                                \
+		if (logLimitAllow(&(_limit), &_iSkipped)) {                                        \
+			if (_iSkipped > 0) {                                                       \
+				LOG_WRN("%u messages suppressed", _iSkipped);                      \
+			}                                                                          \
+			_log(__VA_ARGS__);                                                         \
+		}                                                                                  \
+	} while (0)
+
+bool logLimitAllow(logLimit_t *pLimit, uint32_t *pSkipped);
+
+#else
+
+/* Keeps the definition a declaration; nothing refers to it */
+#define LOG_LIMIT_DEFINE(_name) static const char _name __maybe_unused
+#define LOG_LIMITED(_log, _limit, ...) _log(__VA_ARGS__)
+
+#endif /* CONFIG_RATE_LIMITED_LOG */
+
+#endif /* LOG_LIMIT_H */
@@ -0,0 +1,48 @@
+/*
+ * @file loop_jitter.h
+ * @author Dhruv Mamtora
+ * @version 0.1.0
+ * @date 18 October, 2026
+ *
+ * @brief Fixed-period loop timing with jitter statistics.
+ *
+ * @details
+ * loopJitterWait() ends one pass of a periodic loop: it sleeps until the next absolute
+ * deadline, so the time the loop body takes (including any logging it does) shortens the
+ * sleep instead of stretching the period. Every iWindow passes it logs, in microseconds:
+ *
+ *   - the deviation of the measured period (wake to wake) from the nominal one, min/max/avg;
+ *   - the longest loop body, and how many bodies overran the period;
+ *   - the peak use of the deferred log buffer, when CONFIG_LOG_MEM_UTILIZATION is enabled.
+ *
+ * Build with and without immediate.conf to compare the two logging modes.
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef LOOP_JITTER_H
+#define LOOP_JITTER_H
+
+/** REQUIRED HEADER FILES */
+#include <zephyr/kernel.h>
+
+typedef struct {
+	const char *cName;
+	int64_t iPeriodTicks;
+	int64_t iDeadline;     /* Ticks, start of the next pass */
+	uint32_t iPeriodCyc;
+	uint32_t iWindow;      /* Passes per report */
+	uint32_t iWake;        /* Cycle count at the start of the current pass */
+	uint32_t iCount;       /* Periods measured in this window */
+	int32_t iDevMin;       /* Cycles */
+	int32_t iDevMax;       /* Cycles */
+	uint64_t iAbsDevTotal; /* Cycles */
+	uint32_t iBodyMax;     /* Cycles */
+	uint32_t iOverruns;
+} loopJitter_t;
+
+void loopJitterInit(loopJitter_t *pLoop, const char *cName, uint32_t iPeriodMs,
+		    uint32_t iWindow);
+void loopJitterWait(loopJitter_t *pLoop);
+
+#endif /* LOOP_JITTER_H */
@@ -1,7 +1,7 @@
 /*
  * @file main.c
  * @author Dhruv Mamtora
- * @version 0.1.0
+ * @version 0.2.0
  * @date  31 July, 2025
  *
  * @brief LED Blinking with Debug Logs and Multiple LEDs using Zephyr RTOS
@@ -11,6 +11,12 @@
  * using GPIO device tree bindings in Zephyr. It also enables the logging module
  * at debug level to print messages indicating LED states.
  *
+ * Logging is deferred (see prj.conf): LOG_DBG() only queues the message and the low-priority
+ * log thread prints it, so the loop keeps its CONFIG_LED_PERIOD_MS period whatever the UART
+ * is doing. The LED messages go through a per-module rate limit (log_limit.h) and the loop
+ * reports its period jitter (loop_jitter.h); build with -DEXTRA_CONF_FILE=immediate.conf for
+ * the immediate-mode baseline.
+ *
  * @copyright Copyright (c) 2025
  */
 
@@ -20,12 +26,18 @@
 #include <zephyr/drivers/gpio.h>
 #include <zephyr/logging/log.h>
 
+#include "log_limit.h"
+#include "loop_jitter.h"
+
 /** MACRO DEFINITIONS */
 #define LED0_NODE DT_ALIAS(led0)
 #define LED1_NODE DT_ALIAS(led1)
 #define LED2_NODE DT_ALIAS(led2)
 #define LED3_NODE DT_ALIAS(led3)
 
+/* Periods per jitter report */
+#define LED_JITTER_WINDOW 16
+
 /* Create gpio_dt_spec structures for each LED */
 static const struct gpio_dt_spec led_00 = GPIO_DT_SPEC_GET(LED0_NODE, gpios);
 static const struct gpio_dt_spec led_01 = GPIO_DT_SPEC_GET(LED1_NODE, gpios);
@@ -34,6 +46,7 @@ static const struct gpio_dt_spec led_03 = GPIO_DT_SPEC_GET(LED3_NODE, gpios);
 
 /** LOGGING CONFIGURATION */
 LOG_MODULE_REGISTER(main, LOG_LEVEL_DBG);
+LOG_LIMIT_DEFINE(mainLimit);
 
 /*
  * @brief main - Main application entry point
@@ -43,7 +56,8 @@ LOG_MODULE_REGISTER(main, LOG_LEVEL_DBG);
  *
  * @details
  * Configures each LED pin as output and toggles all LEDs on a fixed interval,
- * while logging the LED state.
+ * while logging the LED state. The interval is kept against absolute deadlines,
+ * so the time spent toggling and logging does not add to it.
  *
  * @pre
  * - All LEDs (led0 to led3) must be defined in the device tree with valid aliases.
@@ -56,6 +70,7 @@ int main(void)
 {
 	int iReturn;
 	bool bLedState = true;
+	loopJitter_t ledLoop;
 
 	if (!gpio_is_ready_dt(&led_00) || !gpio_is_ready_dt(&led_01) ||
 	    !gpio_is_ready_dt(&led_02) || !gpio_is_ready_dt(&led_03)) {
@@ -82,6 +97,8 @@ int main(void)
 		return -1;
 	}
 
+	loopJitterInit(&ledLoop, "led", CONFIG_LED_PERIOD_MS, LED_JITTER_WINDOW);
+
 	while (1) {
 		bLedState = !bLedState;
 
@@ -106,7 +123,7 @@ int main(void)
 		}
 
 		/* Debug Log */
-		LOG_DBG("LED %s", bLedState ? "ON" : "OFF");
-		k_msleep(750);
+		LOG_LIMITED(LOG_DBG, mainLimit, "LED %s", bLedState ? "ON" : "OFF");
+		loopJitterWait(&ledLoop);
 	}
 }
@@ -0,0 +1,60 @@
+/*
+ * @file log_limit.c
+ * @author Dhruv Mamtora
+ * @version 0.1.0
+ * @date 18 October, 2026
+ *
+ * @brief Per-module rate limit for log messages, see log_limit.h.
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+/** REQUIRED HEADER FILES */
+#include <zephyr/kernel.h>
+
+#include "log_limit.h"
+
+/** MACRO DEFINITIONS */
+#define LOG_LIMIT_INTERVAL_TICKS                                                                   \
+	MAX(CONFIG_SYS_CLOCK_TICKS_PER_SEC / CONFIG_RATE_LIMITED_LOG_RATE, 1)
+#define LOG_LIMIT_BURST_TICKS (LOG_LIMIT_INTERVAL_TICKS * (CONFIG_RATE_LIMITED_LOG_BURST - 1))
+
+/*
+ * @brief logLimitAllow - Decide whether a module may log now.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @details
+ * Generic cell rate algorithm: every message moves iNextTicks one interval further, starting
+ * from now when the module has been quiet. A message is allowed while iNextTicks is less than
+ * a burst ahead of now. Costs a spinlock and an uptime read, so it is cheap enough to call on
+ * every pass of a control loop.
+ *
+ * @param[in,out] pLimit Limiter of the calling module.
+ * @param[out] pSkipped Messages suppressed since the last allowed one; only set when the
+ *                      message is allowed.
+ *
+ * @return true if the message may be logged.
+ */
+bool logLimitAllow(logLimit_t *pLimit, uint32_t *pSkipped)
+{
+	int64_t iNow = k_uptime_ticks();
+	k_spinlock_key_t key;
+	bool bAllow;
+
+	key = k_spin_lock(&pLimit->lock);
+
+	bAllow = pLimit->iNextTicks - iNow <= LOG_LIMIT_BURST_TICKS;
+	if (bAllow) {
+		pLimit->iNextTicks = MAX(pLimit->iNextTicks, iNow) + LOG_LIMIT_INTERVAL_TICKS;
+		*pSkipped = pLimit->iSkipped;
+		pLimit->iSkipped = 0;
+	} else {
+		pLimit->iSkipped++;
+	}
+
+	k_spin_unlock(&pLimit->lock, key);
+
+	return bAllow;
+}
@@ -0,0 +1,163 @@
+/*
+ * @file loop_jitter.c
+ * @author Dhruv Mamtora
+ * @version 0.1.0
+ * @date 18 October, 2026
+ *
+ * @brief Fixed-period loop timing with jitter statistics, see loop_jitter.h.
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+/** REQUIRED HEADER FILES */
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/logging/log_ctrl.h>
+
+#include <stdlib.h>
+
+#include "loop_jitter.h"
+
+/** LOGGING CONFIGURATION */
+/* Register the logging module for the loop statistics. */
+LOG_MODULE_REGISTER(loop_jitter, LOG_LEVEL_INF);
+
+/*
+ * @brief cycToUs - Convert a signed cycle count to microseconds.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @param[in] iCycles Cycle count.
+ *
+ * @return Microseconds, with the sign of iCycles.
+ */
+static int32_t cycToUs(int32_t iCycles)
+{
+	int32_t iMicros = (int32_t)k_cyc_to_us_floor32(abs(iCycles));
+
+	return iCycles < 0 ? -iMicros : iMicros;
+}
+
+/*
+ * @brief loopJitterReset - Start a new statistics window.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @param[in,out] pLoop Loop timing state.
+ *
+ * @return None.
+ */
+static void loopJitterReset(loopJitter_t *pLoop)
+{
+	pLoop->iCount = 0;
+	pLoop->iDevMin = INT32_MAX;
+	pLoop->iDevMax = INT32_MIN;
+	pLoop->iAbsDevTotal = 0;
+	pLoop->iBodyMax = 0;
+	pLoop->iOverruns = 0;
+}
+
+/*
+ * @brief loopJitterReport - Log the statistics of the current window.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @param[in] pLoop Loop timing state.
+ *
+ * @return None.
+ */
+static void loopJitterReport(const loopJitter_t *pLoop)
+{
+	uint32_t iBufSize;
+	uint32_t iUsage;
+	uint32_t iMax;
+
+	LOG_INF("%s: period %u us, jitter min %d max %d avg %u us, body max %u us, %u overruns",
+		pLoop->cName, k_cyc_to_us_floor32(pLoop->iPeriodCyc), cycToUs(pLoop->iDevMin),
+		cycToUs(pLoop->iDevMax),
+		k_cyc_to_us_floor32((uint32_t)(pLoop->iAbsDevTotal / pLoop->iCount)),
+		k_cyc_to_us_floor32(pLoop->iBodyMax), pLoop->iOverruns);
+
+	/* Only available in deferred mode with CONFIG_LOG_MEM_UTILIZATION */
+	if (log_mem_get_usage(&iBufSize, &iUsage) == 0 && log_mem_get_max_usage(&iMax) == 0) {
+		LOG_INF("%s: log buffer peak %u of %u bytes", pLoop->cName, iMax, iBufSize);
+	}
+}
+
+/*
+ * @brief loopJitterInit - Prepare the timing of a periodic loop.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @details
+ * Call right before the loop: the first pass starts now and the first deadline is one period
+ * later.
+ *
+ * @param[out] pLoop Loop timing state.
+ * @param[in] cName Name used in the reports.
+ * @param[in] iPeriodMs Nominal period.
+ * @param[in] iWindow Passes per report.
+ *
+ * @return None.
+ */
+void loopJitterInit(loopJitter_t *pLoop, const char *cName, uint32_t iPeriodMs,
+		    uint32_t iWindow)
+{
+	pLoop->cName = cName;
+	pLoop->iPeriodTicks = k_ms_to_ticks_ceil64(iPeriodMs);
+	pLoop->iPeriodCyc = k_ticks_to_cyc_floor32(pLoop->iPeriodTicks);
+	pLoop->iWindow = MAX(iWindow, 1U);
+	pLoop->iDeadline = k_uptime_ticks();
+	pLoop->iWake = k_cycle_get_32();
+	loopJitterReset(pLoop);
+}
+
+/*
+ * @brief loopJitterWait - End a pass of the loop and sleep until the next period starts.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @details
+ * Records the body time of the pass that ends, sleeps to the next absolute deadline and
+ * records the period that ends on wake-up. A body that overran the period finds its deadline
+ * already passed, so the next pass starts at once and the loop catches up instead of drifting.
+ * The report is logged after the body time is taken, so with immediate logging its own UART
+ * time shows up as period jitter.
+ *
+ * @param[in,out] pLoop Loop timing state.
+ *
+ * @return None.
+ */
+void loopJitterWait(loopJitter_t *pLoop)
+{
+	uint32_t iBody = k_cycle_get_32() - pLoop->iWake;
+	uint32_t iWake;
+	int32_t iDev;
+
+	pLoop->iBodyMax = MAX(pLoop->iBodyMax, iBody);
+	if (iBody > pLoop->iPeriodCyc) {
+		pLoop->iOverruns++;
+	}
+
+	if (pLoop->iCount >= pLoop->iWindow) {
+		loopJitterReport(pLoop);
+		loopJitterReset(pLoop);
+	}
+
+	pLoop->iDeadline += pLoop->iPeriodTicks;
+	k_sleep(K_TIMEOUT_ABS_TICKS(pLoop->iDeadline));
+
+	iWake = k_cycle_get_32();
+	iDev = (int32_t)(iWake - pLoop->iWake - pLoop->iPeriodCyc);
+	pLoop->iWake = iWake;
+
+	pLoop->iDevMin = MIN(pLoop->iDevMin, iDev);
+	pLoop->iDevMax = MAX(pLoop->iDevMax, iDev);
+	pLoop->iAbsDevTotal += abs(iDev);
+	pLoop->iCount++;
+}
@@ -1,7 +1,7 @@
 /*
  * @file main.c
  * @author Dhruv Mamtora
- * @version 0.1.0
+ * @version 0.2.0
  * @date 05 August, 2025
  *
  * @brief  PWM-based LED blinking application
@@ -12,6 +12,11 @@
  * supported, and toggles the blinking frequencies of the LEDs in a loop
  * to create a dynamic lighting effect.
  *
+ * printk() goes through the logging subsystem (CONFIG_LOG_PRINTK) in deferred mode, so
+ * neither it nor the per-step LOG_DBG() waits for the UART. The step messages are rate
+ * limited per module (log_limit.h) and the loop reports its period jitter (loop_jitter.h);
+ * build with -DEXTRA_CONF_FILE=immediate.conf for the immediate-mode baseline.
+ *
  * @copyright Copyright (c) 2025
  */
 
@@ -20,15 +25,26 @@
 #include <zephyr/sys/printk.h>
 #include <zephyr/device.h>
 #include <zephyr/drivers/pwm.h>
+#include <zephyr/logging/log.h>
+
+#include "log_limit.h"
+#include "loop_jitter.h"
 
 /** MACRO DEFINITIONS */
 #define MIN_PERIOD PWM_SEC(1U) / 128U
 #define MAX_PERIOD PWM_SEC(1U)
 
+/* Steps per jitter report */
+#define PWM_JITTER_WINDOW 8
+
 /** GLOBAL VARIABLES */
 static const struct pwm_dt_spec pwm_led0 = PWM_DT_SPEC_GET(DT_ALIAS(pwm_led0));
 static const struct pwm_dt_spec pwm_led1 = PWM_DT_SPEC_GET(DT_ALIAS(pwm_led1));
 
+/** LOGGING CONFIGURATION */
+LOG_MODULE_REGISTER(main, LOG_LEVEL_DBG);
+LOG_LIMIT_DEFINE(mainLimit);
+
 /*
  * @brief main - Entry point for PWM-based LED blinking application.
  *
@@ -52,6 +68,8 @@ static const struct pwm_dt_spec pwm_led1 = PWM_DT_SPEC_GET(DT_ALIAS(pwm_led1));
  * - The application uses `pwm_set_dt()` for setting PWM signal parameters.
  * - The period of LED0 increases/decreases exponentially, and LED1 is inverted
  *   to maintain a contrast in blinking rates.
+ * - Steps are CONFIG_PWM_STEP_MS apart, kept against absolute deadlines so that
+ *   setting the PWM and logging do not add to the step period.
  */
 int main(void)
 {
@@ -60,6 +78,7 @@ int main(void)
 	uint32_t iInvertPeriod;
 	uint8_t iDir = 0U;
 	int iReturn;
+	loopJitter_t stepLoop;
 
 	printk("PWM-based blinky\n");
 
@@ -98,6 +117,8 @@ int main(void)
 	printk("Done calibrating; maximum/minimum periods %u/%lu nsec\n", iMaxPeriod, MIN_PERIOD);
 
 	iPeriod = iMaxPeriod;
+	loopJitterInit(&stepLoop, "pwm step", CONFIG_PWM_STEP_MS, PWM_JITTER_WINDOW);
+
 	while (1) {
 
 		iInvertPeriod = iMaxPeriod + MIN_PERIOD - iPeriod;
@@ -114,8 +135,8 @@ int main(void)
 			return 0;
 		}
 
-		printk("&pwm_led0 iPeriod = %d\t\t&pwm_led1 iPeriod = %d \n", iPeriod,
-		       iInvertPeriod);
+		LOG_LIMITED(LOG_DBG, mainLimit, "&pwm_led0 iPeriod = %u, &pwm_led1 iPeriod = %u",
+			    iPeriod, iInvertPeriod);
 
 		iPeriod = iDir ? (iPeriod * 2U) : (iPeriod / 2U);
 		if (iPeriod > iMaxPeriod) {
@@ -126,7 +147,7 @@ int main(void)
 			iDir = 1U;
 		}
 
-		k_sleep(K_SECONDS(4U));
+		loopJitterWait(&stepLoop);
 	}
 	return 0;
 }
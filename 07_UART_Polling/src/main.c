@@ -11,6 +11,9 @@
  * Wait to receive input from the user through UART in polling mode.
  * Echo back received characters.
  *
+ * Reception stays polled; output is queued in a ring buffer and sent by uart_tx()
+ * (uart_tx.c), so the thread does not wait for each character to leave the UART.
+ *
  * @copyright Copyright (c) 2025
  */
 
@@ -19,6 +22,10 @@
 #include <zephyr/device.h>
 #include <zephyr/drivers/uart.h>
 
+#include <string.h>
+
+#include "uart_tx.h"
+
 /** MACRO DEFINITIONS */
 #define UART_DEVICE_NODE DT_CHOSEN(zephyr_shell_uart)
 
@@ -42,6 +49,10 @@ static const struct device *const uartDev = DEVICE_DT_GET(UART_DEVICE_NODE);
  *
  * @retval 0 Success
  * @retval -1 Error
+ *
+ * @error
+ * -ENOTSUP	Asynchronous UART API support not enabled
+ * -ENOSYS	UART device does not support asynchronous API
  */
 int main(void)
 {
@@ -50,13 +61,22 @@ int main(void)
 		return -1;
 	}
 
-	const char *welcomeMsg = "Hello, Welcome to the UART Serial Terminal !\n\r";
+	/* transmit through the TX ring buffer */
+	uartTxInit(uartDev);
+
+	int iReturn = uart_callback_set(uartDev, uartTxCallback, NULL);
 
-	/* Print welcome message */
-	for (int iNum = 0; welcomeMsg[iNum] != '\0'; iNum++) {
-		uart_poll_out(uartDev, welcomeMsg[iNum]);
+	if (iReturn < 0) {
+		printk("Error setting UART callback: %d\n", iReturn);
+		return -1;
 	}
 
+	const char *welcomeMsg = "Hello, Welcome to the UART Serial Terminal !\n\r";
+
+	/* Print welcome message and wait until it is out before polling for input */
+	uartTxWrite(welcomeMsg, strlen(welcomeMsg));
+	uartTxFlush(K_MSEC(100));
+
 	while (1) {
 		uint8_t iReceivedChar;
 
@@ -66,9 +86,11 @@ int main(void)
 		}
 
 		/* Echo the received character */
-		printk("\nreceived char: ");
-		uart_poll_out(uartDev, iReceivedChar);
-        printk("\n");
+		const char *cPrefix = "\nreceived char: ";
+
+		uartTxWrite(cPrefix, strlen(cPrefix));
+		uartTxWrite(&iReceivedChar, 1);
+		uartTxWrite("\n", 1);
 	}
 
 	return 0;
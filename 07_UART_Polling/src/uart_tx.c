@@ -0,0 +1,205 @@
+/*
+ * @file uart_tx.c
+ * @author Dhruv Mamtora
+ * @version 0.1.0
+ * @date 18 October, 2026
+ *
+ * @brief Non-blocking UART transmit through a ring buffer.
+ *
+ * @details
+ * At most one uart_tx() is in flight. It sends a region claimed from the ring buffer, and the
+ * region is only released on UART_TX_DONE, so writers can keep appending meanwhile.
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+/** REQUIRED HEADER FILES */
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/uart.h>
+#include <zephyr/sys/ring_buffer.h>
+
+#include "uart_tx.h"
+
+/** GLOBAL VARIABLES */
+RING_BUF_DECLARE(txRing, UART_TX_BUF_SIZE);
+
+/* Given each time the ring buffer drains and the transmitter goes idle */
+K_SEM_DEFINE(txIdleSem, 0, 1);
+
+static const struct device *txDev;
+static struct k_spinlock txLock;
+static bool bTxBusy;
+static uint32_t iTxClaimed; /* Bytes of the ring buffer passed to the uart_tx() in flight */
+static uartTxStats_t txStats;
+
+/*
+ * @brief startTx - Send the next contiguous region of the ring buffer.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @pre txLock must be held.
+ *
+ * @return None.
+ */
+static void startTx(void)
+{
+	uint8_t *pData;
+
+	if (bTxBusy) {
+		return;
+	}
+
+	iTxClaimed = ring_buf_get_claim(&txRing, &pData, UART_TX_BUF_SIZE);
+	if (iTxClaimed == 0) {
+		k_sem_give(&txIdleSem);
+		return;
+	}
+
+	bTxBusy = true;
+	if (uart_tx(txDev, pData, iTxClaimed, SYS_FOREVER_US) < 0) {
+		/* the driver will not report this region; drop it so the buffer cannot stall */
+		ring_buf_get_finish(&txRing, iTxClaimed);
+		txStats.iDropped += iTxClaimed;
+		iTxClaimed = 0;
+		bTxBusy = false;
+		k_sem_give(&txIdleSem);
+	}
+}
+
+/*
+ * @brief uartTxInit - Select the UART used for transmission.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @details
+ * Does not register a callback; see uart_tx.h.
+ *
+ * @param[in] pDev UART device.
+ *
+ * @return None.
+ */
+void uartTxInit(const struct device *pDev)
+{
+	txDev = pDev;
+}
+
+/*
+ * @brief uartTxCallback - Handle the TX events of the asynchronous UART API.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @details
+ * Runs in interrupt context. Releases the region that was sent and starts the next one.
+ * Other events are ignored.
+ *
+ * @param[in] dev Pointer to UART device structure.
+ * @param[in] evt UART event.
+ * @param[in] user_data Pointer to user data (not used here).
+ *
+ * @return None.
+ */
+void uartTxCallback(const struct device *dev, struct uart_event *evt, void *user_data)
+{
+	k_spinlock_key_t key;
+
+	if (evt->type != UART_TX_DONE && evt->type != UART_TX_ABORTED) {
+		return;
+	}
+
+	key = k_spin_lock(&txLock);
+
+	/* an aborted transfer is not retried; whatever was not sent is dropped */
+	txStats.iSent += evt->data.tx.len;
+	txStats.iDropped += iTxClaimed - evt->data.tx.len;
+	ring_buf_get_finish(&txRing, iTxClaimed);
+	iTxClaimed = 0;
+	bTxBusy = false;
+	startTx();
+
+	k_spin_unlock(&txLock, key);
+}
+
+/*
+ * @brief uartTxWrite - Queue data for transmission.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @details
+ * Never blocks. Copies as much as fits into the ring buffer and starts the transmitter if it
+ * is idle. Safe to call from threads and interrupts.
+ *
+ * @pre uartTxInit() must have been called and TX events must reach uartTxCallback().
+ *
+ * @param[in] pData Data to send.
+ * @param[in] iLen Number of bytes.
+ *
+ * @return Number of bytes queued; less than iLen when the ring buffer is full.
+ */
+size_t uartTxWrite(const void *pData, size_t iLen)
+{
+	k_spinlock_key_t key = k_spin_lock(&txLock);
+	uint32_t iPut = ring_buf_put(&txRing, pData, iLen);
+	uint32_t iUsed = ring_buf_size_get(&txRing);
+
+	txStats.iQueued += iPut;
+	txStats.iDropped += iLen - iPut;
+	txStats.iHighWater = MAX(txStats.iHighWater, iUsed);
+	startTx();
+
+	k_spin_unlock(&txLock, key);
+
+	return iPut;
+}
+
+/*
+ * @brief uartTxFlush - Wait until everything queued has been sent.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @details
+ * Meant for one waiting thread at a time; data queued by other contexts while waiting
+ * extends the wait. Must not be called from an interrupt with a timeout other than K_NO_WAIT.
+ *
+ * @param[in] timeout Maximum time to wait.
+ *
+ * @return 0 when the transmitter is idle, -EAGAIN on timeout.
+ */
+int uartTxFlush(k_timeout_t timeout)
+{
+	k_spinlock_key_t key = k_spin_lock(&txLock);
+	bool bIdle = !bTxBusy && ring_buf_is_empty(&txRing);
+
+	/* drop stale idle signals while the state cannot change */
+	k_sem_reset(&txIdleSem);
+	k_spin_unlock(&txLock, key);
+
+	if (bIdle) {
+		return 0;
+	}
+
+	return k_sem_take(&txIdleSem, timeout);
+}
+
+/*
+ * @brief uartTxStatsGet - Read the transmit counters.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @param[out] pStats Copy of the counters.
+ *
+ * @return None.
+ */
+void uartTxStatsGet(uartTxStats_t *pStats)
+{
+	k_spinlock_key_t key = k_spin_lock(&txLock);
+
+	*pStats = txStats;
+	k_spin_unlock(&txLock, key);
+}
@@ -0,0 +1,47 @@
+/*
+ * @file uart_tx.h
+ * @author Dhruv Mamtora
+ * @version 0.1.0
+ * @date 18 October, 2026
+ *
+ * @brief Non-blocking UART transmit through a ring buffer.
+ *
+ * @details
+ * uartTxWrite() copies the data into a ring buffer and returns; the asynchronous UART API sends
+ * the buffered bytes in contiguous chunks (by DMA where the driver supports it) and starts the
+ * next chunk from the UART_TX_DONE event. The caller is free while the line is busy, instead of
+ * spinning for about 87 us per byte at 115200 baud as uart_poll_out() does.
+ *
+ * Only one callback can be registered per UART, so the application either registers
+ * uartTxCallback() directly or calls it from its own callback for the TX events.
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef UART_TX_H
+#define UART_TX_H
+
+/** REQUIRED HEADER FILES */
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/uart.h>
+
+/** MACRO DEFINITIONS */
+/* Size of the TX ring buffer; writes that do not fit are cut short and counted as dropped */
+#define UART_TX_BUF_SIZE 512
+
+typedef struct {
+	uint32_t iQueued;    /* Bytes accepted by uartTxWrite() */
+	uint32_t iSent;      /* Bytes reported sent by the driver */
+	uint32_t iDropped;   /* Bytes refused because the ring buffer was full */
+	uint32_t iHighWater; /* Largest ring buffer fill seen, in bytes */
+} uartTxStats_t;
+
+/* Function prototypes */
+void uartTxInit(const struct device *pDev);
+void uartTxCallback(const struct device *dev, struct uart_event *evt, void *user_data);
+size_t uartTxWrite(const void *pData, size_t iLen);
+int uartTxFlush(k_timeout_t timeout);
+void uartTxStatsGet(uartTxStats_t *pStats);
+
+#endif /* UART_TX_H */
@@ -0,0 +1,389 @@
+/*
+ * @file line_framer.c
+ * @author Dhruv Mamtora
+ * @version 0.1.0
+ * @date 18 October, 2026
+ *
+ * @brief Zero-copy UART line framing over a single RX ring buffer.
+ *
+ * @details
+ * Positions in the ring are free-running byte counts; the index into the array is the position
+ * modulo LINE_FRAMER_RING_SIZE. Three positions move forward only:
+ *
+ *   - iTail:  oldest byte still in use by a delivered line
+ *   - iHead:  end of the data reported by the driver
+ *   - iClaim: end of the slices handed to the driver
+ *
+ * A slice is only handed out while iClaim stays within one ring of iTail. The array has
+ * LINE_FRAMER_MAX_LINE spare bytes after the ring; the start of a line that wraps is copied
+ * there, so every line view is contiguous. That copy is the only one on the RX path.
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+/** REQUIRED HEADER FILES */
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/uart.h>
+#include <zephyr/sys/atomic.h>
+
+#include <string.h>
+
+#include "line_framer.h"
+
+/** MACRO DEFINITIONS */
+#define FRAMER_THREAD_STACK_SIZE 1024
+#define FRAMER_THREAD_PRIORITY   5
+
+/* Flag set by the UART callback when reception has stopped */
+#define FRAMER_FLAG_RESTART 0
+
+#define RING_INDEX(_pos) ((_pos) & (LINE_FRAMER_RING_SIZE - 1))
+
+BUILD_ASSERT((LINE_FRAMER_RING_SIZE & (LINE_FRAMER_RING_SIZE - 1)) == 0,
+	     "ring size must be a power of two");
+BUILD_ASSERT(LINE_FRAMER_RING_SIZE % LINE_FRAMER_SLICE_SIZE == 0,
+	     "ring size must be a multiple of the slice size");
+BUILD_ASSERT(LINE_FRAMER_MAX_LINE + 2 * LINE_FRAMER_SLICE_SIZE <= LINE_FRAMER_RING_SIZE,
+	     "ring must hold a full line and the two slices owned by the driver");
+
+K_MSGQ_DEFINE(lineMsgq, sizeof(lineView_t), LINE_FRAMER_QUEUE_LEN, 4);
+K_SEM_DEFINE(rxDataSem, 0, 1);
+
+/** GLOBAL VARIABLES */
+static uint8_t ring[LINE_FRAMER_RING_SIZE + LINE_FRAMER_MAX_LINE];
+
+static const struct device *rxDev;
+static atomic_t iTail;
+static atomic_t iHead;
+static uint32_t iClaim;       /* Written by the callback, or by the thread while RX is off */
+static atomic_t iOutstanding; /* Lines queued or held by the consumer */
+static atomic_t flags;
+
+/* framing thread state */
+static uint32_t iScan;      /* Next position to inspect */
+static uint32_t iLineStart; /* Start of the line being assembled */
+static bool bDiscarding;    /* Skipping the rest of a truncated line */
+
+static atomic_t iRxBytes;
+static atomic_t iLines;
+static atomic_t iDropped;
+static atomic_t iTruncated;
+static atomic_t iOverruns;
+static atomic_t iErrors;
+static atomic_t iStarved;
+
+/*
+ * @brief claimSlice - Take the next slice of the ring for the driver.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @return Start of the slice, or NULL when the ring is full.
+ */
+static uint8_t *claimSlice(void)
+{
+	uint8_t *pSlice;
+
+	uint32_t iTailPos = atomic_get(&iTail);
+
+	if (iClaim + LINE_FRAMER_SLICE_SIZE - iTailPos > LINE_FRAMER_RING_SIZE) {
+		return NULL;
+	}
+
+	pSlice = &ring[RING_INDEX(iClaim)];
+	iClaim += LINE_FRAMER_SLICE_SIZE;
+
+	return pSlice;
+}
+
+/*
+ * @brief startRx - Enable reception at the next slice boundary.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @details
+ * Whatever the driver left of a partly filled slice is skipped. Waits while the ring is full,
+ * i.e. until the consumer releases a line.
+ *
+ * @pre Reception must be off.
+ *
+ * @return 0 on success, negative error code from uart_rx_enable() otherwise.
+ */
+static int startRx(void)
+{
+	uint32_t iPos = ROUND_UP((uint32_t)atomic_get(&iHead), LINE_FRAMER_SLICE_SIZE);
+	uint8_t *pSlice;
+
+	atomic_set(&iHead, iPos);
+	iClaim = iPos;
+	iScan = iPos;
+	iLineStart = iPos;
+	bDiscarding = false;
+
+	/* nothing before iPos is needed once the delivered lines are released */
+	while (true) {
+		if (atomic_get(&iOutstanding) == 0) {
+			atomic_set(&iTail, iPos);
+		}
+
+		pSlice = claimSlice();
+		if (pSlice != NULL) {
+			break;
+		}
+		k_msleep(1);
+	}
+
+	return uart_rx_enable(rxDev, pSlice, LINE_FRAMER_SLICE_SIZE, LINE_FRAMER_RX_TIMEOUT_US);
+}
+
+/*
+ * @brief emitLine - Queue a view of [iLineStart, iLineStart + iLen) to the consumer.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @param[in] iLen Line length.
+ * @param[in] bTrunc Whether the line was cut at LINE_FRAMER_MAX_LINE.
+ * @param[in] iNext Position the ring can be freed up to once the line is released.
+ *
+ * @return None.
+ */
+static void emitLine(uint32_t iLen, bool bTrunc, uint32_t iNext)
+{
+	uint32_t iStart = RING_INDEX(iLineStart);
+	lineView_t line = {
+		.pData = (const char *)&ring[iStart],
+		.iNext = iNext,
+		.iLen = iLen,
+		.bTruncated = bTrunc,
+	};
+
+	/* make the view contiguous: copy the wrapped part behind the end of the ring */
+	if (iStart + iLen > LINE_FRAMER_RING_SIZE) {
+		memcpy(&ring[LINE_FRAMER_RING_SIZE], ring, iStart + iLen - LINE_FRAMER_RING_SIZE);
+	}
+
+	atomic_inc(&iOutstanding);
+	if (k_msgq_put(&lineMsgq, &line, K_NO_WAIT) != 0) {
+		atomic_dec(&iOutstanding);
+		atomic_inc(&iDropped);
+		return;
+	}
+
+	atomic_inc(&iLines);
+	if (bTrunc) {
+		atomic_inc(&iTruncated);
+	}
+}
+
+/*
+ * @brief scanLines - Find the line ends in newly received data.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @details
+ * Empty lines, so the second half of "\r\n", are skipped. When no line is outstanding the
+ * skipped bytes are freed at once; otherwise the next release frees them.
+ *
+ * @return None.
+ */
+static void scanLines(void)
+{
+	uint32_t iEnd = atomic_get(&iHead);
+
+	for (; iScan != iEnd; iScan++) {
+		char cChar = ring[RING_INDEX(iScan)];
+
+		if (cChar == '\n' || cChar == '\r') {
+			if (!bDiscarding && iScan != iLineStart) {
+				emitLine(iScan - iLineStart, false, iScan + 1);
+			}
+			bDiscarding = false;
+			iLineStart = iScan + 1;
+		} else if (bDiscarding) {
+			iLineStart = iScan + 1;
+		} else if (iScan + 1 - iLineStart == LINE_FRAMER_MAX_LINE) {
+			emitLine(LINE_FRAMER_MAX_LINE, true, iScan + 1);
+			bDiscarding = true;
+			iLineStart = iScan + 1;
+		}
+	}
+
+	if (atomic_get(&iOutstanding) == 0) {
+		atomic_set(&iTail, iLineStart);
+	}
+}
+
+/*
+ * @brief framerThread - Turn received data into lines and restart reception.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @return None.
+ */
+static void framerThread(void *p1, void *p2, void *p3)
+{
+	int iReturn;
+
+	while (k_sem_take(&rxDataSem, K_FOREVER) == 0) {
+		scanLines();
+
+		if (!atomic_test_and_clear_bit(&flags, FRAMER_FLAG_RESTART)) {
+			continue;
+		}
+
+		/* characters were lost while RX was off; the line in progress is incomplete */
+		if (!bDiscarding && iScan != iLineStart) {
+			atomic_inc(&iDropped);
+		}
+
+		iReturn = startRx();
+		if (iReturn < 0) {
+			printk("Error restarting UART RX: %d\n", iReturn);
+		}
+	}
+}
+
+K_THREAD_DEFINE(framerThreadId, FRAMER_THREAD_STACK_SIZE, framerThread, NULL, NULL, NULL,
+		FRAMER_THREAD_PRIORITY, 0, 0);
+
+/*
+ * @brief lineFramerStart - Start receiving lines.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @pre The UART callback must pass RX events to lineFramerCallback().
+ *
+ * @param[in] pDev UART device.
+ *
+ * @return 0 on success, negative error code from uart_rx_enable() otherwise.
+ */
+int lineFramerStart(const struct device *pDev)
+{
+	rxDev = pDev;
+
+	return startRx();
+}
+
+/*
+ * @brief lineFramerCallback - Handle the RX events of the asynchronous UART API.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @details
+ * Runs in interrupt context. Hands out ring slices and publishes how far the driver has
+ * written; the data itself is already in place. When the ring is full the request is refused,
+ * the driver stops after the current slice and the framing thread restarts it once a line has
+ * been released. Other events are ignored.
+ *
+ * @param[in] dev Pointer to UART device structure.
+ * @param[in] evt UART event.
+ * @param[in] user_data Pointer to user data (not used here).
+ *
+ * @return None.
+ */
+void lineFramerCallback(const struct device *dev, struct uart_event *evt, void *user_data)
+{
+	uint8_t *pSlice;
+
+	switch (evt->type) {
+	case UART_RX_BUF_REQUEST:
+		pSlice = claimSlice();
+		if (pSlice != NULL) {
+			uart_rx_buf_rsp(dev, pSlice, LINE_FRAMER_SLICE_SIZE);
+		} else {
+			atomic_inc(&iStarved);
+		}
+		break;
+
+	case UART_RX_RDY:
+		/* slices are filled in order, so the new bytes always continue at iHead */
+		__ASSERT(evt->data.rx.buf + evt->data.rx.offset ==
+				 &ring[RING_INDEX((uint32_t)atomic_get(&iHead))],
+			 "RX data out of order");
+		atomic_add(&iHead, evt->data.rx.len);
+		atomic_add(&iRxBytes, evt->data.rx.len);
+		k_sem_give(&rxDataSem);
+		break;
+
+	case UART_RX_STOPPED:
+		if (evt->data.rx_stop.reason & UART_ERROR_OVERRUN) {
+			atomic_inc(&iOverruns);
+		} else {
+			atomic_inc(&iErrors);
+		}
+		break;
+
+	case UART_RX_DISABLED:
+		atomic_set_bit(&flags, FRAMER_FLAG_RESTART);
+		k_sem_give(&rxDataSem);
+		break;
+
+	default:
+		break;
+	}
+}
+
+/*
+ * @brief lineFramerGet - Wait for the next line.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @details
+ * The view stays valid until it is passed to lineFramerRelease().
+ *
+ * @param[out] pLine View of the line.
+ * @param[in] timeout Maximum time to wait.
+ *
+ * @return 0 on success, -EAGAIN on timeout.
+ */
+int lineFramerGet(lineView_t *pLine, k_timeout_t timeout)
+{
+	return k_msgq_get(&lineMsgq, pLine, timeout);
+}
+
+/*
+ * @brief lineFramerRelease - Give a line back to the ring.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @pre Every line received before this one must already be released.
+ *
+ * @param[in] pLine View returned by lineFramerGet().
+ *
+ * @return None.
+ */
+void lineFramerRelease(const lineView_t *pLine)
+{
+	atomic_set(&iTail, pLine->iNext);
+	atomic_dec(&iOutstanding);
+}
+
+/*
+ * @brief lineFramerStatsGet - Read the RX and framing counters.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @param[out] pStats Copy of the counters.
+ *
+ * @return None.
+ */
+void lineFramerStatsGet(lineFramerStats_t *pStats)
+{
+	pStats->iRxBytes = atomic_get(&iRxBytes);
+	pStats->iLines = atomic_get(&iLines);
+	pStats->iDropped = atomic_get(&iDropped);
+	pStats->iTruncated = atomic_get(&iTruncated);
+	pStats->iOverruns = atomic_get(&iOverruns);
+	pStats->iErrors = atomic_get(&iErrors);
+	pStats->iStarved = atomic_get(&iStarved);
+}
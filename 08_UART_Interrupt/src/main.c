@@ -1,15 +1,22 @@
 /*
  * @file main.c
  * @author Dhruv Mamtora
- * @version 0.1.0
+ * @version 0.3.0
  * @date 08 August, 2025
  *
  * @brief UART Communication - Transmit & Receive Message by Interrupt
  *
  * @details
  * Transmit a welcome message via UART when the board starts.
- * Wait to receive input from the user through UART in polling mode.
- * Echo back received characters.
+ * Receive input from the user through the asynchronous UART API and echo back received lines.
+ *
+ * The driver writes straight into consecutive slices of one ring buffer; the line framer
+ * (line_framer.c) finds the line ends in thread context and hands out views into the ring, so a
+ * line is never copied. An RX idle timeout delivers partly filled slices, so short commands are
+ * not held back. Send "STATS" to print throughput, overrun and line counters.
+ *
+ * Output is queued in a ring buffer and sent by uart_tx() (uart_tx.c), so printing does not
+ * hold the thread for the serialisation time.
  *
  * @copyright Copyright (c) 2025
  */
@@ -21,20 +28,18 @@
 
 #include <string.h>
 
+#include "line_framer.h"
+#include "uart_tx.h"
+
 /** MACRO DEFINITIONS */
 #define UART_DEVICE_NODE DT_CHOSEN(zephyr_shell_uart)
-#define MSG_SIZE         32
 
-/* Message queue to store up to 10 messages (aligned to 4-byte boundary) */
-K_MSGQ_DEFINE(uartMsgq, MSG_SIZE, 10, 4);
+/* Line rate applied at start-up, e.g. 115200, 921600 or 2000000 */
+#define UART_BAUDRATE 115200
 
 /** GLOBAL VARIABLES */
 static const struct device *const uartDev = DEVICE_DT_GET(UART_DEVICE_NODE);
 
-/* receive buffer used in UART ISR callback */
-static char rxBuf[MSG_SIZE];
-static int rxBufPos;
-
 /*
  * @brief printUart - Print character to console
  *
@@ -43,7 +48,8 @@ static int rxBufPos;
  *
  * @details
  * Print character to console.
- * Send buffer data character by character via uart.
+ * Queue the string for interrupt-driven transmission and return without waiting;
+ * use uartTxFlush() to wait until it has been sent.
  *
  * @pre Uart device must be configured and initialised.
  *
@@ -56,61 +62,113 @@ static int rxBufPos;
  */
 void printUart(char *cBuf)
 {
-	int iMsgLen = strlen(cBuf);
-
-	for (int iNum = 0; iNum < iMsgLen; iNum++) {
-		uart_poll_out(uartDev, cBuf[iNum]);
-	}
+	uartTxWrite(cBuf, strlen(cBuf));
 }
 
 /*
- * @brief readUart - UART RX Interrupt Callback
+ * @brief uartCallback - Asynchronous UART event callback
  *
  * @author Dhruv Mamtora
- * @date 08 August, 2025
+ * @date 18 October, 2026
  *
  * @details
- * UART RX Interrupt Callback to read characters from UART until line end is detected.
- * Afterwards push the data to the message queue.
+ * Runs in interrupt context. Only one callback can be registered per UART, so RX events are
+ * passed to the line framer and TX events to the TX ring buffer.
  *
  * @pre Uart device must be configured and initialised.
  *
  * @syntax
- * void readUart(const struct device *dev, void *user_data);
+ * void uartCallback(const struct device *dev, struct uart_event *evt, void *user_data);
  *
  * @param[in] dev Pointer to UART device structure.
+ * @param[in] evt UART event.
  * @param[in] user_data Pointer to user data (not used here).
  *
  * @return None
  */
-void readUart(const struct device *dev, void *user_data)
+void uartCallback(const struct device *dev, struct uart_event *evt, void *user_data)
 {
-	uint8_t cChar;
-
-	if (!uart_irq_update(uartDev)) {
-		return;
-	}
-
-	if (!uart_irq_rx_ready(uartDev)) {
-		return;
+	switch (evt->type) {
+	case UART_TX_DONE:
+	case UART_TX_ABORTED:
+		uartTxCallback(dev, evt, user_data);
+		break;
+
+	default:
+		lineFramerCallback(dev, evt, user_data);
+		break;
 	}
+}
 
-	/* read until FIFO empty */
-	while (uart_fifo_read(uartDev, &cChar, 1) == 1) {
-		if ((cChar == '\n' || cChar == '\r') && rxBufPos > 0) {
-			/* terminate string */
-			rxBuf[rxBufPos] = '\0';
-
-			/* if queue is full, message is silently dropped */
-			k_msgq_put(&uartMsgq, &rxBuf, K_NO_WAIT);
+/*
+ * @brief lineIs - Compare a received line with a command
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @details
+ * Line views are not NUL terminated, so strcmp() cannot be used on them.
+ *
+ * @syntax
+ * bool lineIs(const lineView_t *pLine, const char *cCmd);
+ *
+ * @param[in] pLine Received line.
+ * @param[in] cCmd Command text.
+ *
+ * @return true when the whole line equals cCmd
+ */
+bool lineIs(const lineView_t *pLine, const char *cCmd)
+{
+	return !pLine->bTruncated && pLine->iLen == strlen(cCmd) &&
+	       memcmp(pLine->pData, cCmd, pLine->iLen) == 0;
+}
 
-			/* reset the buffer (it was copied to the msgq) */
-			rxBufPos = 0;
-		} else if (rxBufPos < (sizeof(rxBuf) - 1)) {
-			rxBuf[rxBufPos++] = cChar;
-		}
-		/* else: characters beyond buffer size are dropped */
-	}
+/*
+ * @brief printRxStats - Print RX counters and throughput
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @details
+ * Throughput is the number of bytes received since the previous call divided by the time
+ * between the two calls. Stream a file into the port, then send "STATS" to read it.
+ * Line framing and TX counters follow on separate lines.
+ *
+ * @syntax
+ * void printRxStats(void);
+ *
+ * @return None
+ */
+void printRxStats(void)
+{
+	static int64_t iLastMs;
+	static uint32_t iLastBytes;
+	char cStatsBuf[160];
+	uartTxStats_t txStats;
+	lineFramerStats_t rxStats;
+	int64_t iNowMs = k_uptime_get();
+	int64_t iElapsedMs = MAX(iNowMs - iLastMs, 1);
+
+	lineFramerStatsGet(&rxStats);
+	snprintk(cStatsBuf, sizeof(cStatsBuf),
+		 "baud=%d rx=%u B rate=%u B/s overruns=%u errors=%u starved=%u\r\n", UART_BAUDRATE,
+		 rxStats.iRxBytes,
+		 (uint32_t)((rxStats.iRxBytes - iLastBytes) * 1000LL / iElapsedMs),
+		 rxStats.iOverruns, rxStats.iErrors, rxStats.iStarved);
+	printUart(cStatsBuf);
+
+	snprintk(cStatsBuf, sizeof(cStatsBuf), "lines=%u dropped=%u truncated=%u max=%d\r\n",
+		 rxStats.iLines, rxStats.iDropped, rxStats.iTruncated, LINE_FRAMER_MAX_LINE);
+	printUart(cStatsBuf);
+
+	uartTxStatsGet(&txStats);
+	snprintk(cStatsBuf, sizeof(cStatsBuf),
+		 "tx=%u B sent=%u B dropped=%u B high-water=%u/%d B\r\n", txStats.iQueued,
+		 txStats.iSent, txStats.iDropped, txStats.iHighWater, UART_TX_BUF_SIZE);
+	printUart(cStatsBuf);
+
+	iLastMs = iNowMs;
+	iLastBytes = rxStats.iRxBytes;
 }
 
 /*
@@ -121,8 +179,8 @@ void readUart(const struct device *dev, void *user_data)
  *
  * @details
  * Transmit a Welcome message via UART when board starts.
- * Wait to receive input from the user through UART in interrupt mode.
- * Echo back received characters.
+ * Wait to receive input from the user through the asynchronous UART API.
+ * Echo back received lines.
  *
  * @pre device node must be defined in the device tree.
  *
@@ -132,26 +190,37 @@ void readUart(const struct device *dev, void *user_data)
  * @retval -1 Error code description
  *
  * @error
- * -ENOTSUP	Interrupt-driven UART API support not enabled
- * -ENOSYS	UART device does not support interrupt-driven API
+ * -ENOTSUP	Asynchronous UART API support not enabled
+ * -ENOSYS	UART device does not support asynchronous API
  */
 int main(void)
 {
-	char cTxBuf[MSG_SIZE];
+	lineView_t line;
+	struct uart_config uartCfg;
 
 	if (!device_is_ready(uartDev)) {
 		printk("UART device not ready\n");
 		return -1;
 	}
 
-	/* configure interrupt and callback to receive data */
-	int iReturn = uart_irq_callback_user_data_set(uartDev, readUart, NULL);
+	/* apply the requested line rate; keep the devicetree rate if the driver refuses */
+	if (uart_config_get(uartDev, &uartCfg) == 0 && uartCfg.baudrate != UART_BAUDRATE) {
+		uartCfg.baudrate = UART_BAUDRATE;
+		if (uart_configure(uartDev, &uartCfg) < 0) {
+			printk("Cannot set baud rate %d\n", UART_BAUDRATE);
+		}
+	}
+
+	uartTxInit(uartDev);
+
+	/* configure callback to receive data and complete transmissions */
+	int iReturn = uart_callback_set(uartDev, uartCallback, NULL);
 
 	if (iReturn < 0) {
 		if (iReturn == -ENOTSUP) {
-			printk("Interrupt-driven UART API support not enabled\n");
+			printk("Asynchronous UART API support not enabled\n");
 		} else if (iReturn == -ENOSYS) {
-			printk("UART device does not support interrupt-driven API\n");
+			printk("UART device does not support asynchronous API\n");
 		} else {
 			printk("Error setting UART callback: %d\n", iReturn);
 		}
@@ -160,16 +229,26 @@ int main(void)
 
 	const char *welcomeMsg = "Hello, Welcome to the UART Serial Terminal !\n\r";
 
-	uart_irq_rx_enable(uartDev);
+	iReturn = lineFramerStart(uartDev);
+	if (iReturn < 0) {
+		printk("Error enabling UART RX: %d\n", iReturn);
+		return -1;
+	}
 
 	/* Print welcome message */
 	printUart((char *)welcomeMsg);
 
-	/* wait for messages from the UART */
-	while (k_msgq_get(&uartMsgq, &cTxBuf, K_FOREVER) == 0) {
-		printUart("Echo: ");
-		printUart(cTxBuf);
-		printUart("\r\n");
+	/* wait for lines from the UART; each is read in place and then released */
+	while (lineFramerGet(&line, K_FOREVER) == 0) {
+		if (lineIs(&line, "STATS")) {
+			printRxStats();
+		} else {
+			printUart("Echo: ");
+			uartTxWrite(line.pData, line.iLen);
+			printUart(line.bTruncated ? "...\r\n" : "\r\n");
+		}
+
+		lineFramerRelease(&line);
 	}
 
 	return 0;
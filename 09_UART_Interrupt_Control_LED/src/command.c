@@ -0,0 +1,371 @@
+/*
+ * @file command.c
+ * @author Dhruv Mamtora
+ * @version 0.1.0
+ * @date 18 October, 2026
+ *
+ * @brief Table-driven UART command dispatcher with a rate limiter.
+ *
+ * @details
+ * The rate limiter is a GCRA (generic cell rate algorithm): it keeps the time at which the next
+ * command is due and lets commands through while that time is at most CMD_RATE_BURST - 1
+ * intervals ahead of the clock. It is only used from the thread that executes commands.
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+/** REQUIRED HEADER FILES */
+#include <zephyr/kernel.h>
+
+#include <string.h>
+
+#include "command.h"
+#include "uart_tx.h"
+
+/** MACRO DEFINITIONS */
+#define CMD_INTERVAL_US (USEC_PER_SEC / CMD_RATE_PER_SEC)
+#define CMD_BURST_US    (CMD_INTERVAL_US * (CMD_RATE_BURST - 1))
+
+typedef struct {
+	uint32_t iCalls;
+	uint32_t iErrors;
+	uint64_t iTotalCycles; /* Handler run time */
+	uint32_t iMaxCycles;
+} cmdStats_t;
+
+/** GLOBAL VARIABLES */
+static const command_t *cmdTable;
+static int iCmdCount;
+/* Table index + 1 for each hash slot; 0 marks an empty slot */
+static uint8_t cmdIndex[CMD_HASH_SIZE];
+static cmdStats_t cmdStats[CMD_MAX_COMMANDS];
+
+static uint64_t iNextDueUs; /* GCRA theoretical arrival time */
+static uint32_t iRateDelayed;
+static uint64_t iRateWaitUs;
+
+/*
+ * @brief cmdHash - FNV-1a hash of a command word.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @param[in] pData Characters, not NUL terminated.
+ * @param[in] iLen Number of characters.
+ *
+ * @return Hash slot, below CMD_HASH_SIZE.
+ */
+static uint32_t cmdHash(const char *pData, size_t iLen)
+{
+	uint32_t iHash = 2166136261u;
+
+	for (size_t i = 0; i < iLen; i++) {
+		iHash ^= (uint8_t)pData[i];
+		iHash *= 16777619u;
+	}
+
+	return iHash & (CMD_HASH_SIZE - 1);
+}
+
+/*
+ * @brief cmdLookup - Find the table entry for a command word.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @param[in] pWord Command word.
+ *
+ * @return Index into the command table, or -1 when the word is unknown.
+ */
+static int cmdLookup(const cmdToken_t *pWord)
+{
+	uint32_t iSlot = cmdHash(pWord->pData, pWord->iLen);
+
+	for (int i = 0; i < CMD_HASH_SIZE && cmdIndex[iSlot] != 0; i++) {
+		int iEntry = cmdIndex[iSlot] - 1;
+
+		if (cmdTokenIs(pWord, cmdTable[iEntry].cName)) {
+			return iEntry;
+		}
+		iSlot = (iSlot + 1) & (CMD_HASH_SIZE - 1);
+	}
+
+	return -1;
+}
+
+/*
+ * @brief cmdRateWait - Take a token from the rate limiter, waiting if none is left.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @details
+ * Commands within the burst return at once. Beyond it, the caller sleeps until its token is
+ * due; the UART keeps receiving into the line framer meanwhile.
+ *
+ * @return None.
+ */
+static void cmdRateWait(void)
+{
+	uint64_t iNowUs = k_ticks_to_us_floor64(k_uptime_ticks());
+
+	if (iNextDueUs < iNowUs) {
+		iNextDueUs = iNowUs;
+	}
+
+	if (iNextDueUs - iNowUs > CMD_BURST_US) {
+		uint64_t iWaitUs = iNextDueUs - iNowUs - CMD_BURST_US;
+
+		iRateDelayed++;
+		iRateWaitUs += iWaitUs;
+		k_usleep((int32_t)iWaitUs);
+	}
+
+	iNextDueUs += CMD_INTERVAL_US;
+}
+
+/*
+ * @brief cmdReply - Send the status of one command.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @param[in] iStatus Handler result or dispatcher error.
+ * @param[in] pWord Command word, used in error replies.
+ * @param[in] pCmd Table entry, or NULL for an unknown command.
+ *
+ * @return None.
+ */
+static void cmdReply(int iStatus, const cmdToken_t *pWord, const command_t *pCmd)
+{
+	char cReplyBuf[96];
+
+	if (iStatus == 0) {
+		uartTxWrite("OK\r\n", 4);
+		return;
+	}
+
+	if (pCmd == NULL) {
+		snprintk(cReplyBuf, sizeof(cReplyBuf), "ERR unknown command '%.*s'\r\n",
+			 MIN(pWord->iLen, 32), pWord->pData);
+	} else if (iStatus == -EINVAL) {
+		snprintk(cReplyBuf, sizeof(cReplyBuf), "ERR usage: %s\r\n", pCmd->cUsage);
+	} else {
+		snprintk(cReplyBuf, sizeof(cReplyBuf), "ERR %s failed (%d)\r\n", pCmd->cName,
+			 iStatus);
+	}
+	uartTxWrite(cReplyBuf, strlen(cReplyBuf));
+}
+
+/*
+ * @brief cmdExecute - Parse and run one command.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @details
+ * Splits the text on spaces and tabs, checks the argument count against the table entry and
+ * times the handler in hardware cycles. Empty commands are ignored.
+ *
+ * @param[in] pText Command text, not NUL terminated.
+ * @param[in] iLen Number of characters.
+ *
+ * @return 0 on success, 1 when the command failed, -1 when there was nothing to run.
+ */
+static int cmdExecute(const char *pText, size_t iLen)
+{
+	cmdToken_t argv[CMD_MAX_ARGS];
+	const command_t *pCmd;
+	int iArgc = 0;
+	int iEntry;
+	int iStatus;
+	size_t i = 0;
+
+	while (i < iLen) {
+		while (i < iLen && (pText[i] == ' ' || pText[i] == '\t')) {
+			i++;
+		}
+		if (i == iLen) {
+			break;
+		}
+
+		size_t iStart = i;
+
+		while (i < iLen && pText[i] != ' ' && pText[i] != '\t') {
+			i++;
+		}
+
+		if (iArgc == CMD_MAX_ARGS) {
+			/* counted so the argument check below rejects the command */
+			iArgc++;
+			break;
+		}
+		argv[iArgc].pData = &pText[iStart];
+		argv[iArgc].iLen = i - iStart;
+		iArgc++;
+	}
+
+	if (iArgc == 0) {
+		return -1;
+	}
+
+	cmdRateWait();
+
+	iEntry = cmdLookup(&argv[0]);
+	if (iEntry < 0) {
+		cmdReply(-ENOENT, &argv[0], NULL);
+		return 1;
+	}
+
+	pCmd = &cmdTable[iEntry];
+	if (iArgc - 1 < pCmd->iMinArgs || iArgc - 1 > pCmd->iMaxArgs) {
+		iStatus = -EINVAL;
+	} else {
+		uint32_t iStart = k_cycle_get_32();
+		uint32_t iCycles;
+
+		iStatus = pCmd->handler(iArgc, argv);
+		iCycles = k_cycle_get_32() - iStart;
+
+		cmdStats[iEntry].iTotalCycles += iCycles;
+		cmdStats[iEntry].iMaxCycles = MAX(cmdStats[iEntry].iMaxCycles, iCycles);
+	}
+
+	cmdStats[iEntry].iCalls++;
+	if (iStatus != 0) {
+		cmdStats[iEntry].iErrors++;
+	}
+	cmdReply(iStatus, &argv[0], pCmd);
+
+	return iStatus != 0;
+}
+
+/*
+ * @brief commandInit - Index a command table.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @details
+ * The table is kept by reference and must stay valid; it is normally a static const array.
+ * Collisions are resolved by linear probing.
+ *
+ * @param[in] pTable Commands.
+ * @param[in] iCount Number of entries.
+ *
+ * @return 0 on success, -ENOSPC when there are more than CMD_MAX_COMMANDS entries,
+ *         -EEXIST when a name appears twice.
+ */
+int commandInit(const command_t *pTable, int iCount)
+{
+	if (iCount > CMD_MAX_COMMANDS) {
+		return -ENOSPC;
+	}
+
+	cmdTable = pTable;
+	iCmdCount = 0;
+	memset(cmdIndex, 0, sizeof(cmdIndex));
+	memset(cmdStats, 0, sizeof(cmdStats));
+
+	for (int i = 0; i < iCount; i++) {
+		cmdToken_t name = {pTable[i].cName, strlen(pTable[i].cName)};
+		uint32_t iSlot = cmdHash(name.pData, name.iLen);
+
+		if (cmdLookup(&name) >= 0) {
+			return -EEXIST;
+		}
+
+		while (cmdIndex[iSlot] != 0) {
+			iSlot = (iSlot + 1) & (CMD_HASH_SIZE - 1);
+		}
+		cmdIndex[iSlot] = i + 1;
+		iCmdCount++;
+	}
+
+	return 0;
+}
+
+/*
+ * @brief commandExecuteLine - Run every command on a line.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @details
+ * Commands are separated by ';' and run in order; a failing command does not stop the rest.
+ * Each command is answered on its own line. May sleep in the rate limiter.
+ *
+ * @pre commandInit() must have been called.
+ *
+ * @param[in] pLine Line without its terminator, not NUL terminated.
+ * @param[in] iLen Number of characters.
+ *
+ * @return Number of commands that failed.
+ */
+int commandExecuteLine(const char *pLine, size_t iLen)
+{
+	int iFailed = 0;
+	size_t iStart = 0;
+
+	for (size_t i = 0; i <= iLen; i++) {
+		if (i == iLen || pLine[i] == ';') {
+			if (cmdExecute(&pLine[iStart], i - iStart) > 0) {
+				iFailed++;
+			}
+			iStart = i + 1;
+		}
+	}
+
+	return iFailed;
+}
+
+/*
+ * @brief commandPrintStats - Print call counts and handler latency per command.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @details
+ * Latency is the handler run time only, from k_cycle_get_32(); parsing, lookup and the reply
+ * are not included. Rate limiter delays are printed separately.
+ *
+ * @return None.
+ */
+void commandPrintStats(void)
+{
+	char cStatsBuf[96];
+
+	for (int i = 0; i < iCmdCount; i++) {
+		const cmdStats_t *pStats = &cmdStats[i];
+		uint32_t iAvgCycles = pStats->iCalls ? pStats->iTotalCycles / pStats->iCalls : 0;
+
+		snprintk(cStatsBuf, sizeof(cStatsBuf),
+			 "%-6s calls=%u errors=%u avg=%u ns max=%u ns\r\n", cmdTable[i].cName,
+			 pStats->iCalls, pStats->iErrors, (uint32_t)k_cyc_to_ns_floor64(iAvgCycles),
+			 (uint32_t)k_cyc_to_ns_floor64(pStats->iMaxCycles));
+		uartTxWrite(cStatsBuf, strlen(cStatsBuf));
+	}
+
+	snprintk(cStatsBuf, sizeof(cStatsBuf), "rate=%d/s burst=%d delayed=%u wait=%u us\r\n",
+		 CMD_RATE_PER_SEC, CMD_RATE_BURST, iRateDelayed, (uint32_t)iRateWaitUs);
+	uartTxWrite(cStatsBuf, strlen(cStatsBuf));
+}
+
+/*
+ * @brief cmdTokenIs - Compare a token with a string.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @details
+ * Tokens are not NUL terminated, so strcmp() cannot be used on them.
+ *
+ * @param[in] pToken Token.
+ * @param[in] cText NUL terminated string.
+ *
+ * @return true when the whole token equals cText.
+ */
+bool cmdTokenIs(const cmdToken_t *pToken, const char *cText)
+{
+	return pToken->iLen == strlen(cText) && memcmp(pToken->pData, cText, pToken->iLen) == 0;
+}
@@ -0,0 +1,66 @@
+/*
+ * @file command.h
+ * @author Dhruv Mamtora
+ * @version 0.1.0
+ * @date 18 October, 2026
+ *
+ * @brief Table-driven UART command dispatcher with a rate limiter.
+ *
+ * @details
+ * The application passes a static command table to commandInit(), which indexes it in a small
+ * open-addressing hash table; a lookup hashes the command word once and usually compares one
+ * name. commandExecuteLine() splits a line into commands separated by ';', splits each command
+ * into space-separated arguments and runs the handler, so "LED ON; TOGGLE; STATS" is one line.
+ * Arguments are views into the line; nothing is copied.
+ *
+ * Every command takes one token from a rate limiter (CMD_RATE_PER_SEC, bursts of
+ * CMD_RATE_BURST). A command arriving faster waits only until its token is due, so bursts pass
+ * at full speed and sustained floods are paced instead of every command being delayed.
+ *
+ * Each command is answered with "OK" or "ERR <reason>". Calls, errors and handler run time are
+ * recorded per command and printed by commandPrintStats().
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef COMMAND_H
+#define COMMAND_H
+
+/** REQUIRED HEADER FILES */
+#include <zephyr/kernel.h>
+
+/** MACRO DEFINITIONS */
+/* Largest number of commands in a table */
+#define CMD_MAX_COMMANDS 8
+/* Hash slots; a power of two, at least twice CMD_MAX_COMMANDS to keep probe chains short */
+#define CMD_HASH_SIZE    16
+/* Command word plus arguments */
+#define CMD_MAX_ARGS     4
+
+/* Sustained commands per second and the burst allowed above that rate */
+#define CMD_RATE_PER_SEC 500
+#define CMD_RATE_BURST   32
+
+typedef struct {
+	const char *pData; /* Not NUL terminated */
+	uint16_t iLen;
+} cmdToken_t;
+
+/* Returns 0 on success or a negative error code, which is reported as "ERR" */
+typedef int (*cmdHandler_t)(int iArgc, const cmdToken_t *pArgv);
+
+typedef struct {
+	const char *cName;
+	cmdHandler_t handler;
+	uint8_t iMinArgs; /* Arguments after the command word */
+	uint8_t iMaxArgs;
+	const char *cUsage;
+} command_t;
+
+/* Function prototypes */
+int commandInit(const command_t *pTable, int iCount);
+int commandExecuteLine(const char *pLine, size_t iLen);
+void commandPrintStats(void);
+bool cmdTokenIs(const cmdToken_t *pToken, const char *cText);
+
+#endif /* COMMAND_H */
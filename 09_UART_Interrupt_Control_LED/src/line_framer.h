@@ -0,0 +1,68 @@
+/*
+ * @file line_framer.h
+ * @author Dhruv Mamtora
+ * @version 0.1.0
+ * @date 18 October, 2026
+ *
+ * @brief Zero-copy UART line framing over a single RX ring buffer.
+ *
+ * @details
+ * The asynchronous UART driver receives directly into consecutive slices of one ring buffer.
+ * A framing thread finds the line ends and queues lineView_t descriptors that point into the
+ * ring; the consumer reads the line in place and hands it back with lineFramerRelease(), which
+ * frees its bytes for reception. Lines must be released in the order they were received.
+ *
+ * Lines longer than LINE_FRAMER_MAX_LINE are delivered cut at that length with bTruncated set,
+ * and the rest up to the line end is skipped. A line is dropped when the descriptor queue is
+ * full or when reception restarts in the middle of it.
+ *
+ * The UART callback must pass RX events to lineFramerCallback().
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef LINE_FRAMER_H
+#define LINE_FRAMER_H
+
+/** REQUIRED HEADER FILES */
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/uart.h>
+
+/** MACRO DEFINITIONS */
+/* Longest line delivered whole, not counting the line end */
+#define LINE_FRAMER_MAX_LINE   256
+/* RX ring buffer; a power of two and a multiple of the slice size */
+#define LINE_FRAMER_RING_SIZE  1024
+/* Part of the ring handed to the driver per RX buffer request */
+#define LINE_FRAMER_SLICE_SIZE 64
+/* Lines delivered but not yet released */
+#define LINE_FRAMER_QUEUE_LEN  8
+/* Deliver received data after this much line idle time (a few characters at 115200) */
+#define LINE_FRAMER_RX_TIMEOUT_US 1000
+
+typedef struct {
+	const char *pData; /* Line text in the ring buffer, not NUL terminated */
+	uint32_t iNext;    /* Ring position after the line end; used by lineFramerRelease() */
+	uint16_t iLen;
+	bool bTruncated;
+} lineView_t;
+
+typedef struct {
+	uint32_t iRxBytes;
+	uint32_t iLines;     /* Lines delivered, truncated ones included */
+	uint32_t iDropped;   /* Lines lost to a full queue or an RX restart */
+	uint32_t iTruncated; /* Lines longer than LINE_FRAMER_MAX_LINE */
+	uint32_t iOverruns;  /* Characters lost in the UART (UART_ERROR_OVERRUN) */
+	uint32_t iErrors;    /* Framing, parity and break errors */
+	uint32_t iStarved;   /* Buffer requests refused because the ring was full */
+} lineFramerStats_t;
+
+/* Function prototypes */
+int lineFramerStart(const struct device *pDev);
+void lineFramerCallback(const struct device *dev, struct uart_event *evt, void *user_data);
+int lineFramerGet(lineView_t *pLine, k_timeout_t timeout);
+void lineFramerRelease(const lineView_t *pLine);
+void lineFramerStatsGet(lineFramerStats_t *pStats);
+
+#endif /* LINE_FRAMER_H */
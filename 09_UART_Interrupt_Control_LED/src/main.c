@@ -1,7 +1,7 @@
 /*
  * @file main.c
  * @author Dhruv Mamtora
- * @version 0.1.0
+ * @version 0.4.0
  * @date 08 August, 2025
  *
  * @brief Control LED via UART Commands
@@ -12,6 +12,14 @@
  * b. Based on the command, turn ON, OFF, or TOGGLE an LED.
  * c. Use UART reception either via polling or interrupts.
  *
+ * Reception uses the asynchronous UART API with an RX idle timeout. The driver writes straight
+ * into the line framer's ring buffer (line_framer.c) and commands are compared in place, up to
+ * LINE_FRAMER_MAX_LINE characters. Commands are looked up in a hashed table (command.c) and
+ * several can be sent on one line separated by ';', e.g. "LED ON; TOGGLE; STATS". Each is
+ * answered with "OK" or "ERR ...". A rate limiter paces sustained floods (CMD_RATE_PER_SEC);
+ * "STATS" prints throughput, overrun and line counters and "LAT" the per-command latency.
+ * Output is queued in a ring buffer and sent by uart_tx() (uart_tx.c).
+ *
  * @copyright Copyright (c) 2025
  */
 
@@ -23,23 +31,21 @@
 
 #include <string.h>
 
+#include "command.h"
+#include "line_framer.h"
+#include "uart_tx.h"
+
 /** MACRO DEFINITIONS */
 #define LED0_NODE        DT_ALIAS(led0)
 #define UART_DEVICE_NODE DT_CHOSEN(zephyr_shell_uart)
 
-#define MSG_SIZE 32
-
-/* Message queue to store up to 10 messages (aligned to 4-byte boundary) */
-K_MSGQ_DEFINE(uartMsgq, MSG_SIZE, 10, 4);
+/* Line rate applied at start-up, e.g. 115200, 921600 or 2000000 */
+#define UART_BAUDRATE 115200
 
 /** GLOBAL VARIABLES */
 static const struct gpio_dt_spec led = GPIO_DT_SPEC_GET(LED0_NODE, gpios);
 static const struct device *const uartDev = DEVICE_DT_GET(UART_DEVICE_NODE);
 
-/* receive buffer used in UART ISR callback */
-static char rxBuf[MSG_SIZE];
-static int rxBufPos;
-
 /*
  * @brief printUart - Print character to console
  *
@@ -48,7 +54,8 @@ static int rxBufPos;
  *
  * @details
  * Print character to console.
- * Send buffer data character by character via uart.
+ * Queue the string for interrupt-driven transmission and return without waiting;
+ * use uartTxFlush() to wait until it has been sent.
  *
  * @pre Uart device must be configured and initialised.
  *
@@ -61,63 +68,174 @@ static int rxBufPos;
  */
 void printUart(char *cBuf)
 {
-	int iMsgLen = strlen(cBuf);
-
-	for (int iNum = 0; iNum < iMsgLen; iNum++) {
-		uart_poll_out(uartDev, cBuf[iNum]);
-	}
+	uartTxWrite(cBuf, strlen(cBuf));
 }
 
 /*
- * @brief readUart - UART RX Interrupt Callback
+ * @brief uartCallback - Asynchronous UART event callback
  *
  * @author Dhruv Mamtora
- * @date 08 August, 2025
+ * @date 18 October, 2026
  *
  * @details
- * UART RX Interrupt Callback to read characters from UART until line end is detected.
- * Afterwards push the data to the message queue.
+ * Runs in interrupt context. Only one callback can be registered per UART, so RX events are
+ * passed to the line framer and TX events to the TX ring buffer.
  *
  * @pre Uart device must be configured and initialised.
  *
  * @syntax
- * void readUart(const struct device *dev, void *user_data);
+ * void uartCallback(const struct device *dev, struct uart_event *evt, void *user_data);
  *
  * @param[in] dev Pointer to UART device structure.
+ * @param[in] evt UART event.
  * @param[in] user_data Pointer to user data (not used here).
  *
  * @return None
  */
-void readUart(const struct device *dev, void *user_data)
+void uartCallback(const struct device *dev, struct uart_event *evt, void *user_data)
 {
-	uint8_t c;
+	switch (evt->type) {
+	case UART_TX_DONE:
+	case UART_TX_ABORTED:
+		uartTxCallback(dev, evt, user_data);
+		break;
 
-	if (!uart_irq_update(uartDev)) {
-		return;
+	default:
+		lineFramerCallback(dev, evt, user_data);
+		break;
 	}
+}
 
-	if (!uart_irq_rx_ready(uartDev)) {
-		return;
-	}
+/*
+ * @brief printRxStats - Print RX counters and throughput
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @details
+ * Throughput is the number of bytes received since the previous call divided by the time
+ * between the two calls. Stream a file into the port, then send "STATS" to read it.
+ * Line framing and TX counters follow on separate lines.
+ *
+ * @syntax
+ * void printRxStats(void);
+ *
+ * @return None
+ */
+void printRxStats(void)
+{
+	static int64_t iLastMs;
+	static uint32_t iLastBytes;
+	char cStatsBuf[160];
+	uartTxStats_t txStats;
+	lineFramerStats_t rxStats;
+	int64_t iNowMs = k_uptime_get();
+	int64_t iElapsedMs = MAX(iNowMs - iLastMs, 1);
 
-	/* read until FIFO empty */
-	while (uart_fifo_read(uartDev, &c, 1) == 1) {
-		if ((c == '\n' || c == '\r') && rxBufPos > 0) {
-			/* terminate string */
-			rxBuf[rxBufPos] = '\0';
+	lineFramerStatsGet(&rxStats);
+	snprintk(cStatsBuf, sizeof(cStatsBuf),
+		 "baud=%d rx=%u B rate=%u B/s overruns=%u errors=%u starved=%u\r\n", UART_BAUDRATE,
+		 rxStats.iRxBytes,
+		 (uint32_t)((rxStats.iRxBytes - iLastBytes) * 1000LL / iElapsedMs),
+		 rxStats.iOverruns, rxStats.iErrors, rxStats.iStarved);
+	printUart(cStatsBuf);
 
-			/* if queue is full, message is silently dropped */
-			k_msgq_put(&uartMsgq, &rxBuf, K_NO_WAIT);
+	snprintk(cStatsBuf, sizeof(cStatsBuf), "lines=%u dropped=%u truncated=%u max=%d\r\n",
+		 rxStats.iLines, rxStats.iDropped, rxStats.iTruncated, LINE_FRAMER_MAX_LINE);
+	printUart(cStatsBuf);
 
-			/* reset the buffer (it was copied to the msgq) */
-			rxBufPos = 0;
-		} else if (rxBufPos < (sizeof(rxBuf) - 1)) {
-			rxBuf[rxBufPos++] = c;
-		}
-		/* else: characters beyond buffer size are dropped */
+	uartTxStatsGet(&txStats);
+	snprintk(cStatsBuf, sizeof(cStatsBuf),
+		 "tx=%u B sent=%u B dropped=%u B high-water=%u/%d B\r\n", txStats.iQueued,
+		 txStats.iSent, txStats.iDropped, txStats.iHighWater, UART_TX_BUF_SIZE);
+	printUart(cStatsBuf);
+
+	iLastMs = iNowMs;
+	iLastBytes = rxStats.iRxBytes;
+}
+
+/*
+ * @brief cmdLed - LED ON | OFF | TOGGLE
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @param[in] iArgc Number of tokens, including the command word.
+ * @param[in] pArgv Tokens.
+ *
+ * @return 0 on success, -EINVAL for an unknown state, or the GPIO error code.
+ */
+static int cmdLed(int iArgc, const cmdToken_t *pArgv)
+{
+	if (cmdTokenIs(&pArgv[1], "ON")) {
+		return gpio_pin_set_dt(&led, 1); /* Turn ON LED */
+	} else if (cmdTokenIs(&pArgv[1], "OFF")) {
+		return gpio_pin_set_dt(&led, 0); /* Turn OFF LED */
+	} else if (cmdTokenIs(&pArgv[1], "TOGGLE")) {
+		return gpio_pin_toggle_dt(&led);
 	}
+
+	return -EINVAL;
 }
 
+/*
+ * @brief cmdToggle - TOGGLE
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @param[in] iArgc Number of tokens, including the command word.
+ * @param[in] pArgv Tokens.
+ *
+ * @return 0 on success or the GPIO error code.
+ */
+static int cmdToggle(int iArgc, const cmdToken_t *pArgv)
+{
+	return gpio_pin_toggle_dt(&led); /* TOGGLE LED state*/
+}
+
+/*
+ * @brief cmdStats - STATS
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @param[in] iArgc Number of tokens, including the command word.
+ * @param[in] pArgv Tokens.
+ *
+ * @return 0
+ */
+static int cmdStats(int iArgc, const cmdToken_t *pArgv)
+{
+	printRxStats();
+	return 0;
+}
+
+/*
+ * @brief cmdLat - LAT
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @param[in] iArgc Number of tokens, including the command word.
+ * @param[in] pArgv Tokens.
+ *
+ * @return 0
+ */
+static int cmdLat(int iArgc, const cmdToken_t *pArgv)
+{
+	commandPrintStats();
+	return 0;
+}
+
+/* Command word, handler, min and max arguments, usage */
+static const command_t commands[] = {
+	{"LED", cmdLed, 1, 1, "LED ON|OFF|TOGGLE"},
+	{"TOGGLE", cmdToggle, 0, 0, "TOGGLE"},
+	{"STATS", cmdStats, 0, 0, "STATS"},
+	{"LAT", cmdLat, 0, 0, "LAT"},
+};
+
 /*
  * @brief main - Entry point for UART Communication app.
  *
@@ -125,10 +243,10 @@ void readUart(const struct device *dev, void *user_data)
  * @date 08 August, 2025
  *
  * @details
- * Initialize UART and GPIO devices, set up UART interrupt handling,
+ * Initialize UART and GPIO devices, set up asynchronous UART reception,
  * and process incoming UART messages to control an LED.
- * Supported commands are "LED ON", "LED OFF", and "TOGGLE".
- * The application echoes received messages back to the sender.
+ * Supported commands are "LED ON", "LED OFF", "LED TOGGLE", "TOGGLE", "STATS" and "LAT".
+ * Every command is answered with "OK" or "ERR ...".
  *
  * @pre device node must be defined in the device tree.
  *
@@ -138,12 +256,14 @@ void readUart(const struct device *dev, void *user_data)
  * @retval -1 Error code description
  *
  * @error
- * -ENOTSUP	Interrupt-driven UART API support not enabled
- * -ENOSYS	UART device does not support interrupt-driven API
+ * -ENOTSUP	Asynchronous UART API support not enabled
+ * -ENOSYS	UART device does not support asynchronous API
  */
 int main(void)
 {
-	char txBuf[MSG_SIZE];
+	lineView_t line;
+	struct uart_config uartCfg;
+	int iReturn;
 
 	if (!gpio_is_ready_dt(&led)) {
 		return -1;
@@ -158,14 +278,30 @@ int main(void)
 		return -1;
 	}
 
-	/* configure interrupt and callback to receive data */
-	int iReturn = uart_irq_callback_user_data_set(uartDev, readUart, NULL);
+	/* apply the requested line rate; keep the devicetree rate if the driver refuses */
+	if (uart_config_get(uartDev, &uartCfg) == 0 && uartCfg.baudrate != UART_BAUDRATE) {
+		uartCfg.baudrate = UART_BAUDRATE;
+		if (uart_configure(uartDev, &uartCfg) < 0) {
+			printk("Cannot set baud rate %d\n", UART_BAUDRATE);
+		}
+	}
+
+	uartTxInit(uartDev);
+
+	iReturn = commandInit(commands, ARRAY_SIZE(commands));
+	if (iReturn < 0) {
+		printk("Error building command table: %d\n", iReturn);
+		return -1;
+	}
+
+	/* configure callback to receive data and complete transmissions */
+	iReturn = uart_callback_set(uartDev, uartCallback, NULL);
 
 	if (iReturn < 0) {
 		if (iReturn == -ENOTSUP) {
-			printk("Interrupt-driven UART API support not enabled\n");
+			printk("Asynchronous UART API support not enabled\n");
 		} else if (iReturn == -ENOSYS) {
-			printk("UART device does not support interrupt-driven API\n");
+			printk("UART device does not support asynchronous API\n");
 		} else {
 			printk("Error setting UART callback: %d\n", iReturn);
 		}
@@ -174,26 +310,22 @@ int main(void)
 
 	const char *welcomeMsg = "Hello, Welcome to the UART Serial Terminal !\n\r";
 
-	uart_irq_rx_enable(uartDev);
+	iReturn = lineFramerStart(uartDev);
+	if (iReturn < 0) {
+		printk("Error enabling UART RX: %d\n", iReturn);
+		return -1;
+	}
 
 	printUart((char *)welcomeMsg);
 
-	/* wait for messages from the UART */
-	while (k_msgq_get(&uartMsgq, &txBuf, K_FOREVER) == 0) {
-		printUart("Echo: ");
-		printUart(txBuf);
-		printUart("\r\n");
-
-		if (strcmp(txBuf, "LED ON") == 0) {
-			gpio_pin_set_dt(&led, 1); /* Turn ON LED */
-		} else if (strcmp(txBuf, "LED OFF") == 0) {
-			gpio_pin_set_dt(&led, 0); /* Turn OFF LED */
-		} else if (strcmp(txBuf, "TOGGLE") == 0) {
-			gpio_pin_toggle_dt(&led); /* TOGGLE LED state*/
+	/* wait for lines from the UART; each is executed in place and then released */
+	while (lineFramerGet(&line, K_FOREVER) == 0) {
+		if (line.bTruncated) {
+			printUart("ERR line too long\r\n");
 		} else {
-			printUart("Unknown command! write 'LED ON', 'LED OFF', 'TOGGLE'\r\n");
+			commandExecuteLine(line.pData, line.iLen);
 		}
-		k_msleep(1000); /* Small delay to avoid flooding the UART */
+		lineFramerRelease(&line);
 	}
 	return 0;
 }
@@ -0,0 +1,133 @@
+/*
+ * @file counter.h
+ * @author Dhruv Mamtora
+ * @version 0.1.0
+ * @date 18 October, 2026
+ *
+ * @brief Event counter with four update strategies.
+ *
+ * @details
+ * Every thread that counts gets its own counterHandle_t and calls counterAdd() on it. The mode
+ * chosen at counterInit() decides what an add costs and when other threads see it:
+ *
+ *   - COUNTER_MODE_MUTEX:   one shared value under a k_mutex, or under the profiled mutex
+ *                           wrapper when counterInit() is asked for statistics; exact at any
+ *                           time
+ *   - COUNTER_MODE_ATOMIC:  one shared atomic_inc(); exact at any time
+ *   - COUNTER_MODE_SHARDED: each handle writes its own cache-line sized shard with a relaxed
+ *                           load and store, no barrier; counterMerge(), called periodically,
+ *                           publishes the sum for counterRead()
+ *   - COUNTER_MODE_BATCHED: each handle counts locally and adds COUNTER_BATCH_SIZE at a time
+ *                           to the shared atomic; counterFlush() adds the remainder
+ *
+ * counterAdd() is inline so the mode switch is the only overhead on top of the update itself.
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef COUNTER_H
+#define COUNTER_H
+
+/** REQUIRED HEADER FILES */
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+
+#include "profiled_mutex.h"
+
+/** MACRO DEFINITIONS */
+/* Largest number of handles counting into one sharded counter */
+#define COUNTER_MAX_SHARDS 8
+/* Shards are padded to this size so two CPUs never write the same cache line */
+#define COUNTER_CACHE_LINE 64
+/* Local increments per shared update in batched mode */
+#define COUNTER_BATCH_SIZE 64
+
+typedef enum {
+	COUNTER_MODE_MUTEX,
+	COUNTER_MODE_ATOMIC,
+	COUNTER_MODE_SHARDED,
+	COUNTER_MODE_BATCHED,
+	COUNTER_MODE_COUNT,
+} counterMode_t;
+
+typedef struct {
+	atomic_t count; /* Written by its owning handle only */
+} __aligned(COUNTER_CACHE_LINE) counterShard_t;
+
+typedef struct {
+	counterMode_t eMode;
+	bool bProfiled;        /* COUNTER_MODE_MUTEX: lock through the profiler */
+	profiledMutex_t mutex; /* COUNTER_MODE_MUTEX */
+	uint32_t iValue;       /* COUNTER_MODE_MUTEX */
+	atomic_t total;        /* Value of the other modes; last merge in sharded mode */
+	counterShard_t shards[COUNTER_MAX_SHARDS];
+} counter_t;
+
+typedef struct {
+	counter_t *pCounter;
+	counterShard_t *pShard; /* COUNTER_MODE_SHARDED */
+	uint32_t iPending;      /* COUNTER_MODE_BATCHED */
+} counterHandle_t;
+
+/* Function prototypes */
+void counterInit(counter_t *pCounter, counterMode_t eMode, bool bProfiled);
+void counterHandleInit(counterHandle_t *pHandle, counter_t *pCounter, int iShard);
+void counterFlush(counterHandle_t *pHandle);
+void counterMerge(counter_t *pCounter);
+uint32_t counterRead(counter_t *pCounter);
+const char *counterModeName(counterMode_t eMode);
+
+/*
+ * @brief counterAdd - Count one event.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @details
+ * Must only be called by the thread that owns the handle.
+ *
+ * @param[in] pHandle Handle of the calling thread.
+ *
+ * @return None.
+ */
+static inline void counterAdd(counterHandle_t *pHandle)
+{
+	counter_t *pCounter = pHandle->pCounter;
+
+	switch (pCounter->eMode) {
+	case COUNTER_MODE_MUTEX:
+		if (pCounter->bProfiled) {
+			profiledMutexLock(&pCounter->mutex, K_FOREVER);
+			pCounter->iValue++;
+			profiledMutexUnlock(&pCounter->mutex);
+		} else {
+			k_mutex_lock(&pCounter->mutex.mutex, K_FOREVER);
+			pCounter->iValue++;
+			k_mutex_unlock(&pCounter->mutex.mutex);
+		}
+		break;
+
+	case COUNTER_MODE_ATOMIC:
+		atomic_inc(&pCounter->total);
+		break;
+
+	case COUNTER_MODE_SHARDED:
+		/* Single writer: a relaxed store is enough, no locked read-modify-write or barrier */
+		__atomic_store_n(&pHandle->pShard->count,
+				 __atomic_load_n(&pHandle->pShard->count, __ATOMIC_RELAXED) + 1,
+				 __ATOMIC_RELAXED);
+		break;
+
+	case COUNTER_MODE_BATCHED:
+		if (++pHandle->iPending == COUNTER_BATCH_SIZE) {
+			atomic_add(&pCounter->total, COUNTER_BATCH_SIZE);
+			pHandle->iPending = 0;
+		}
+		break;
+
+	default:
+		break;
+	}
+}
+
+#endif /* COUNTER_H */
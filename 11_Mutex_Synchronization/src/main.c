@@ -18,6 +18,18 @@
  * @details
  * Created 2 threads that increment same counter 100times.
  * Used Mutex to synchronisation and prevent data corruption.
+ * With CONFIG_PROFILED_MUTEX the mutex also reports how often and how long the threads waited
+ * for each other (profiled_mutex.c).
+ *
+ * The counter itself lives in counter.c and can also count with atomic_inc, per-thread shards
+ * merged by a timer, or batched local increments. After the two-thread demo, every mode is
+ * timed with 1 to MY_MAX_THREADS threads and printed as CSV, the mutex mode with the bare
+ * k_mutex rather than the profiled wrapper:
+ *
+ *   mode,threads,ops,cycles,cycles_per_op,speedup,ok
+ *
+ * speedup is the throughput relative to one thread of the same mode, in hundredths. Build for
+ * qemu_x86_64 (boards/qemu_x86_64.conf enables SMP) to see how each mode scales across CPUs.
  *
  * @copyright Copyright (c) 2025
  */
@@ -26,6 +38,8 @@
 #include <zephyr/kernel.h>
 #include <zephyr/device.h>
 
+#include "counter.h"
+
 /** MACRO DEFINITIONS */
 /* size of stack area used by each thread */
 #define MY_STACK_SIZE 1024
@@ -33,69 +47,123 @@
 #define MY_PRIORITY   5
 #define MY_INCREMENT  100000
 
+/* Threads of the scaling benchmark; at most COUNTER_MAX_SHARDS */
+#define MY_MAX_THREADS 4
+/* Period of the shard merge while a sharded run is counting */
+#define MY_MERGE_PERIOD K_MSEC(1)
+
 /** GLOBAL VARIABLES */
-int iCounter = 0;
-/* Define Mutex */
-K_MUTEX_DEFINE(counterMutex);
+/* Shared counter */
+static counter_t counter;
+
+/* Opened by main once per run so all threads start together */
+K_SEM_DEFINE(startGate, 0, MY_MAX_THREADS);
+
+/* Merges the shards of a sharded counter while it is being counted */
+static struct k_timer mergeTimer;
 
 /* Define thread stacks */
-K_THREAD_STACK_DEFINE(stack1, MY_STACK_SIZE);
-K_THREAD_STACK_DEFINE(stack2, MY_STACK_SIZE);
+K_THREAD_STACK_ARRAY_DEFINE(stacks, MY_MAX_THREADS, MY_STACK_SIZE);
 
 /* Thread control blocks */
-struct k_thread thread1;
-struct k_thread thread2;
+struct k_thread threads[MY_MAX_THREADS];
 
 /*
- * @brief incrementCounter1 - Increment counter with Mutex
+ * @brief incrementCounter - Increment the shared counter MY_INCREMENT times.
  *
  * @author Dhruv Mamtora
  * @date 11 August, 2025
  *
  * @details
- * Increment the shared counter with the use of mutex to prevent data corruption.
+ * Waits at the start gate, counts through its own handle and flushes the handle before
+ * returning so that batched increments are not lost.
+ *
+ * @pre counter must be initialised.
  *
- * @pre Mutex must be defined and initialised.
+ * @param[in] a Thread index, used as the shard.
+ * @param[in] b Unused.
+ * @param[in] c Unused.
  *
  * @return None.
  *
  * @global
- * iCounter increments.
+ * counter increments.
  */
-void incrementCounter1(void *a, void *b, void *C)
+void incrementCounter(void *a, void *b, void *c)
 {
+	counterHandle_t handle;
+
+	counterHandleInit(&handle, &counter, (int)(uintptr_t)a);
+	k_sem_take(&startGate, K_FOREVER);
+
 	for (int iNum = 0; iNum < MY_INCREMENT; iNum++) {
-		k_mutex_lock(&counterMutex, K_FOREVER);
-		iCounter++;
-		k_mutex_unlock(&counterMutex);
+		counterAdd(&handle);
 	}
-	printk("Thread 1 finished incrementing counter1. counter = %d \n", iCounter);
+
+	counterFlush(&handle);
 }
 
 /*
- * @brief incrementCounter2 - Increment counter with Mutex
+ * @brief mergeTimerExpiry - Periodic merge of the sharded counter.
  *
  * @author Dhruv Mamtora
- * @date 11 August, 2025
+ * @date 18 October, 2026
  *
- * @details
- * Increment the shared counter with the use of mutex to prevent data corruption.
- *
- * @pre Mutex must be defined and initialised.
+ * @param[in] timer Expired timer.
  *
  * @return None.
+ */
+static void mergeTimerExpiry(struct k_timer *timer)
+{
+	counterMerge(&counter);
+}
+
+/*
+ * @brief runCounter - Count with iThreads threads in the given mode.
  *
- * @global
- * iCounter increments.
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @details
+ * Threads are created at MY_PRIORITY, below main, so they all wait at the start gate until
+ * main opens it. The time runs from opening the gate to the last join.
+ *
+ * @param[in] eMode Counter mode.
+ * @param[in] iThreads Number of threads.
+ * @param[in] bProfiled Lock the mutex mode through the profiler, see counterInit().
+ *
+ * @return Elapsed hardware cycles.
  */
-void incrementCounter2(void *a, void *b, void *C)
+static uint32_t runCounter(counterMode_t eMode, int iThreads, bool bProfiled)
 {
-	for (int iNum = 0; iNum < MY_INCREMENT; iNum++) {
-		k_mutex_lock(&counterMutex, K_FOREVER);
-		iCounter++;
-		k_mutex_unlock(&counterMutex);
+	counterInit(&counter, eMode, bProfiled);
+
+	for (int iNum = 0; iNum < iThreads; iNum++) {
+		k_thread_create(&threads[iNum], stacks[iNum], MY_STACK_SIZE, incrementCounter,
+				(void *)(uintptr_t)iNum, NULL, NULL, MY_PRIORITY, 0, K_NO_WAIT);
+	}
+
+	if (eMode == COUNTER_MODE_SHARDED) {
+		k_timer_start(&mergeTimer, MY_MERGE_PERIOD, MY_MERGE_PERIOD);
+	}
+
+	uint32_t iStart = k_cycle_get_32();
+
+	for (int iNum = 0; iNum < iThreads; iNum++) {
+		k_sem_give(&startGate);
 	}
-	printk("Thread 2 finished incrementing counter2. counter = %d \n", iCounter);
+
+	/* Wait for all threads to finish */
+	for (int iNum = 0; iNum < iThreads; iNum++) {
+		k_thread_join(&threads[iNum], K_FOREVER);
+	}
+
+	uint32_t iCycles = k_cycle_get_32() - iStart;
+
+	k_timer_stop(&mergeTimer);
+	counterMerge(&counter);
+
+	return iCycles;
 }
 
 /*
@@ -105,7 +173,7 @@ void incrementCounter2(void *a, void *b, void *C)
  * @date 04 September, 2025
  *
  * @details
- * Initialise Mutex and create threads. Wait for final counter number.
+ * Run the original two-thread mutex demo, then the scaling benchmark of every counter mode.
  *
  * @return 0.
  *
@@ -113,19 +181,39 @@ void incrementCounter2(void *a, void *b, void *C)
  */
 int main(void)
 {
-	k_mutex_init(&counterMutex);
+	k_timer_init(&mergeTimer, mergeTimerExpiry, NULL);
+
+	runCounter(COUNTER_MODE_MUTEX, 2, true);
+	printk("Final counter value: %u\n", counterRead(&counter));
+	profiledMutexPrint(&counter.mutex);
 
-	k_thread_create(&thread1, stack1, MY_STACK_SIZE, incrementCounter1, NULL, NULL, NULL,
-			MY_PRIORITY, 0, K_NO_WAIT);
+	printk("# %u CPU(s), %u cycles/s\n", (uint32_t)arch_num_cpus(),
+	       sys_clock_hw_cycles_per_sec());
+	printk("mode,threads,ops,cycles,cycles_per_op,speedup,ok\n");
 
-	k_thread_create(&thread2, stack2, MY_STACK_SIZE, incrementCounter2, NULL, NULL, NULL,
-			MY_PRIORITY, 0, K_NO_WAIT);
+	for (int iMode = 0; iMode < COUNTER_MODE_COUNT; iMode++) {
+		uint64_t iBaseCyclesPerOp = 0;
 
-	/* Wait for both threads to finish */
-	k_thread_join(&thread1, K_FOREVER);
-	k_thread_join(&thread2, K_FOREVER);
+		for (int iThreads = 1; iThreads <= MY_MAX_THREADS; iThreads++) {
+			uint32_t iOps = (uint32_t)iThreads * MY_INCREMENT;
+			/* Bare k_mutex, so the mutex rows compare like with like */
+			uint32_t iCycles = runCounter(iMode, iThreads, false);
+			/* Hundredths of a cycle, so fast modes do not round to 0 */
+			uint64_t iCentiCyclesPerOp = ((uint64_t)iCycles * 100) / iOps;
 
-	printk("Final counter value: %d\n", iCounter);
+			if (iThreads == 1) {
+				iBaseCyclesPerOp = iCentiCyclesPerOp;
+			}
+
+			printk("%s,%d,%u,%u,%u.%02u,%u,%d\n", counterModeName(iMode), iThreads,
+			       iOps, iCycles, (uint32_t)(iCentiCyclesPerOp / 100),
+			       (uint32_t)(iCentiCyclesPerOp % 100),
+			       iCentiCyclesPerOp ? (uint32_t)((iBaseCyclesPerOp * 100) /
+							       iCentiCyclesPerOp)
+						 : 0,
+			       counterRead(&counter) == iOps);
+		}
+	}
 
 	return 0;
 }
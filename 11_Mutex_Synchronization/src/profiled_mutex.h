@@ -0,0 +1,85 @@
+/*
+ * @file profiled_mutex.h
+ * @author Dhruv Mamtora
+ * @version 0.1.0
+ * @date 18 October, 2026
+ *
+ * @brief Mutex wrapper that records contention statistics.
+ *
+ * @details
+ * profiledMutexLock/profiledMutexUnlock are used in place of k_mutex_lock/k_mutex_unlock.
+ * They count acquisitions and acquisitions that had to wait, and add up the wait and hold
+ * times in hardware cycles. The statistics are only written while the mutex is held, so they
+ * need no extra locking.
+ *
+ * With CONFIG_PROFILED_MUTEX=n the wrapper holds only the k_mutex and every call compiles to
+ * the plain kernel call.
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef PROFILED_MUTEX_H
+#define PROFILED_MUTEX_H
+
+/** REQUIRED HEADER FILES */
+#include <zephyr/kernel.h>
+
+typedef struct {
+	struct k_mutex mutex;
+#ifdef CONFIG_PROFILED_MUTEX
+	const char *cName;
+	uint32_t iLockedAt;   /* Cycle count when the current owner got the lock */
+	uint32_t iAcquired;   /* Outermost acquisitions */
+	uint32_t iContended;  /* Acquisitions that had to wait */
+	uint32_t iTimeouts;   /* Lock calls that gave up */
+	uint64_t iWaitTotal;  /* Cycles */
+	uint32_t iWaitMax;    /* Cycles */
+	uint64_t iHoldTotal;  /* Cycles */
+	uint32_t iHoldMax;    /* Cycles */
+#endif
+} profiledMutex_t;
+
+#ifdef CONFIG_PROFILED_MUTEX
+
+#define PROFILED_MUTEX_DEFINE(_name)                                                               \
+	profiledMutex_t _name = {                                                                  \
+		.mutex = Z_MUTEX_INITIALIZER(_name.mutex),                                         \
+		.cName = #_name,                                                                   \
+	}
+
+void profiledMutexInit(profiledMutex_t *pMutex, const char *cName);
+int profiledMutexLock(profiledMutex_t *pMutex, k_timeout_t timeout);
+int profiledMutexUnlock(profiledMutex_t *pMutex);
+void profiledMutexPrint(const profiledMutex_t *pMutex);
+
+#else
+
+#define PROFILED_MUTEX_DEFINE(_name)                                                               \
+	profiledMutex_t _name = {                                                                  \
+		.mutex = Z_MUTEX_INITIALIZER(_name.mutex),                                         \
+	}
+
+static inline void profiledMutexInit(profiledMutex_t *pMutex, const char *cName)
+{
+	ARG_UNUSED(cName);
+	k_mutex_init(&pMutex->mutex);
+}
+
+static inline int profiledMutexLock(profiledMutex_t *pMutex, k_timeout_t timeout)
+{
+	return k_mutex_lock(&pMutex->mutex, timeout);
+}
+
+static inline int profiledMutexUnlock(profiledMutex_t *pMutex)
+{
+	return k_mutex_unlock(&pMutex->mutex);
+}
+
+static inline void profiledMutexPrint(const profiledMutex_t *pMutex)
+{
+	ARG_UNUSED(pMutex);
+}
+
+#endif /* CONFIG_PROFILED_MUTEX */
+
+#endif /* PROFILED_MUTEX_H */
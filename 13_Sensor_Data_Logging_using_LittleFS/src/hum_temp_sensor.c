@@ -1,7 +1,9 @@
 #include "hum_temp_sensor.h"
 #include "sensor_shared.h"
+#include "telemetry.h"
 
 #include <zephyr/device.h>
+#include <zephyr/drivers/i2c.h>
 #include <zephyr/drivers/sensor.h>
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
@@ -12,10 +14,50 @@ LOG_MODULE_REGISTER(hum_temp);
 #if DT_NODE_EXISTS(DT_ALIAS(ht_sensor))
 #define HUM_TEMP_NODE DT_ALIAS(ht_sensor)
 const struct device *const hts_dev = DEVICE_DT_GET(DT_ALIAS(ht_sensor));
+static const struct i2c_dt_spec hts_bus = I2C_DT_SPEC_GET(HUM_TEMP_NODE);
 #else
 #error ("Humidity-Temperature sensor not found.");
 #endif
 
+/* AV_CONF: AVGT[5:3] and AVGH[2:0] select the number of internal averaged conversions */
+#define HTS221_REG_AV_CONF 0x10
+#define HTS221_AV_CONF(avgt, avgh) (((avgt) << 3) | (avgh))
+
+/* Matches the sensor's reset value (AVGT = 16, AVGH = 32) */
+#define HTS221_DEFAULT_PROFILE SENSOR_PROFILE_BALANCED
+
+static const uint8_t hts_av_conf[SENSOR_PROFILE_COUNT] = {
+    /* AVGT = 2, AVGH = 4: lowest supply current, highest noise */
+    [SENSOR_PROFILE_LOW_POWER] = HTS221_AV_CONF(0, 0),
+    /* AVGT = 16, AVGH = 32 */
+    [SENSOR_PROFILE_BALANCED] = HTS221_AV_CONF(3, 3),
+    /* AVGT = 256, AVGH = 512: lowest noise */
+    [SENSOR_PROFILE_LOW_NOISE] = HTS221_AV_CONF(7, 7),
+};
+
+static enum sensor_profile hts_profile = HTS221_DEFAULT_PROFILE;
+
+int hum_temp_sensor_set_profile(enum sensor_profile profile)
+{
+    if (profile >= SENSOR_PROFILE_COUNT) {
+        return -EINVAL;
+    }
+
+    int rc = i2c_reg_write_byte_dt(&hts_bus, HTS221_REG_AV_CONF, hts_av_conf[profile]);
+    if (rc < 0) {
+        LOG_ERR("Cannot write HTS221 AV_CONF (%d)", rc);
+        return rc;
+    }
+
+    hts_profile = profile;
+    return 0;
+}
+
+enum sensor_profile hum_temp_sensor_get_profile(void)
+{
+    return hts_profile;
+}
+
 void hum_temp_sensor_process_sample(void)
 {
     if (!device_is_ready(hts_dev)) {
@@ -39,10 +81,16 @@ void hum_temp_sensor_process_sample(void)
         return;
     }
 
-    k_mutex_lock(&sensor_data_mutex, K_FOREVER);
+    profiled_mutex_lock(&sensor_data_mutex, K_FOREVER);
     sensor_data.temperature = sensor_value_to_double(&temp);
     sensor_data.humidity = sensor_value_to_double(&hum);
-    k_mutex_unlock(&sensor_data_mutex);
+    profiled_mutex_unlock(&sensor_data_mutex);
+
+    telemetry_send_hum_temp(&temp, &hum);
+
+    if (!IS_ENABLED(CONFIG_SENSOR_LOG_READINGS)) {
+        return;
+    }
 
     /* display temperature */
     LOG_INF("Temperature:%.1f C", sensor_value_to_double(&temp));
@@ -58,6 +106,10 @@ int hun_temp_sensor_init(void)
         return -1;
     }
 
+    if (hum_temp_sensor_set_profile(HTS221_DEFAULT_PROFILE) < 0) {
+        LOG_WRN("Keeping HTS221 averaging at reset value");
+    }
+
     hum_temp_sensor_process_sample();
 
     return 0;
@@ -1,7 +1,11 @@
 #ifndef HUM_TEMP_SENSOR_H
 #define HUM_TEMP_SENSOR_H
 
+#include "sensor_shared.h"
+
 void hum_temp_sensor_process_sample(void);
+int hum_temp_sensor_set_profile(enum sensor_profile profile);
+enum sensor_profile hum_temp_sensor_get_profile(void);
 int hun_temp_sensor_init(void);
 
 #endif /* HUM_TEMP_SENSOR_H */
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "imu_sensor.h"
 #include "sensor_shared.h"
+#include "telemetry.h"
 
 #include <zephyr/device.h>
 #include <zephyr/drivers/sensor.h>
@@ -22,7 +23,6 @@ void imu_sensor_sample_process(void)
         LOG_ERR("Sensor sample update error");
         return;
     }
-    char out_str[64];
     struct sensor_value accel_x, accel_y, accel_z;
     struct sensor_value gyro_x, gyro_y, gyro_z;
 
@@ -32,15 +32,17 @@ void imu_sensor_sample_process(void)
     sensor_channel_get(imu_dev, SENSOR_CHAN_ACCEL_Y, &accel_y);
     sensor_channel_get(imu_dev, SENSOR_CHAN_ACCEL_Z, &accel_z);
 
-    sprintf(out_str, "accel x:%f ms/2 y:%f ms/2 z:%f ms/2", sensor_value_to_double(&accel_x),
-            sensor_value_to_double(&accel_y), sensor_value_to_double(&accel_z));
-    LOG_INF("%s", out_str);
+    if (IS_ENABLED(CONFIG_SENSOR_LOG_READINGS)) {
+        /* raw doubles; formatting is left to the log backend or, with dictionary logs, the host */
+        LOG_INF("accel x:%.3f y:%.3f z:%.3f m/s^2", sensor_value_to_double(&accel_x),
+                sensor_value_to_double(&accel_y), sensor_value_to_double(&accel_z));
+    }
 
-    k_mutex_lock(&sensor_data_mutex, K_FOREVER);
+    profiled_mutex_lock(&sensor_data_mutex, K_FOREVER);
     sensor_data.accel_x = sensor_value_to_double(&accel_x);
     sensor_data.accel_y = sensor_value_to_double(&accel_y);
     sensor_data.accel_z = sensor_value_to_double(&accel_z);
-    k_mutex_unlock(&sensor_data_mutex);
+    profiled_mutex_unlock(&sensor_data_mutex);
 
     /* lsm6dsl gyro */
     sensor_sample_fetch_chan(imu_dev, SENSOR_CHAN_GYRO_XYZ);
@@ -48,15 +50,21 @@ void imu_sensor_sample_process(void)
     sensor_channel_get(imu_dev, SENSOR_CHAN_GYRO_Y, &gyro_y);
     sensor_channel_get(imu_dev, SENSOR_CHAN_GYRO_Z, &gyro_z);
 
-    sprintf(out_str, "gyro x:%f dps y:%f dps z:%f dps", sensor_value_to_double(&gyro_x),
-            sensor_value_to_double(&gyro_y), sensor_value_to_double(&gyro_z));
-    LOG_INF("%s", out_str);
+    if (IS_ENABLED(CONFIG_SENSOR_LOG_READINGS)) {
+        LOG_INF("gyro x:%.3f y:%.3f z:%.3f rad/s", sensor_value_to_double(&gyro_x),
+                sensor_value_to_double(&gyro_y), sensor_value_to_double(&gyro_z));
+    }
 
-    k_mutex_lock(&sensor_data_mutex, K_FOREVER);
+    profiled_mutex_lock(&sensor_data_mutex, K_FOREVER);
     sensor_data.gyro_x = sensor_value_to_double(&gyro_x);
     sensor_data.gyro_y = sensor_value_to_double(&gyro_y);
     sensor_data.gyro_z = sensor_value_to_double(&gyro_z);
-    k_mutex_unlock(&sensor_data_mutex);
+    profiled_mutex_unlock(&sensor_data_mutex);
+
+    const struct sensor_value accel[3] = {accel_x, accel_y, accel_z};
+    const struct sensor_value gyro[3] = {gyro_x, gyro_y, gyro_z};
+
+    telemetry_send_imu(accel, gyro);
 }
 
 int imu_sensor_init(void)
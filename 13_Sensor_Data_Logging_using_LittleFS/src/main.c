@@ -1,41 +1,54 @@
 #include "hum_temp_sensor.h"
 #include "imu_sensor.h"
 #include "pressure_sensor.h"
+#include "profiled_mutex.h"
+#include "sensor_config.h"
 #include "sensor_shared.h"
 #include "sensor_storage.h"
+#include "sensor_worker.h"
+#include "telemetry.h"
 
 #include <zephyr/kernel.h>
 #include <zephyr/sys/util.h>
 
 #include <zephyr/logging/log.h>
+#include <zephyr/logging/log_ctrl.h>
 #include <zephyr/shell/shell.h>
 
 #include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 #define STACK_SIZE 1024
 #define PRIORITY   5
-#define SLEEP_TIME K_SECONDS(5)
 
 #define STORAGE_STACK_SIZE 1024 * 4
 #define STORAGE_PRIORITY   4
-#define STORAGE_INTERVAL   K_MINUTES(1)
 
-K_THREAD_STACK_DEFINE(hum_temp_stack, STACK_SIZE);
-K_THREAD_STACK_DEFINE(pressure_stack, STACK_SIZE);
-K_THREAD_STACK_DEFINE(imu_stack, STACK_SIZE);
-K_THREAD_STACK_DEFINE(storage_stack, STORAGE_STACK_SIZE);
-
-static struct k_thread hum_temp_thread_data;
-static struct k_thread pressure_thread_data;
-static struct k_thread imu_thread_data;
-static struct k_thread storage_thread_data;
-
-static k_tid_t hum_temp_tid, pressure_tid, imu_tid, storage_tid;
-
-static bool terminate_hum_temp_thread = false;
-static bool terminate_pressure_thread = false;
-static bool terminate_imu_thread = false;
-static bool terminate_storage_thread = false;
+/* Rounds of the five reading messages per "sensor logbench" run */
+#define LOG_BENCH_MAX_COUNT 200
+/* Log buffer space of a reading message with three doubles, rounded up */
+#define LOG_BENCH_MSG_SIZE  64
+#define LOG_BENCH_DRAIN_MS  10000
+
+static void sensor_storage_work(void);
+
+SENSOR_WORKER_DEFINE(hum_temp_worker, hum_temp_sensor_process_sample, SENSOR_CONFIG_HUM_TEMP_MS,
+		     STACK_SIZE, PRIORITY);
+SENSOR_WORKER_DEFINE(pressure_worker, pressure_sensor_process_sample, SENSOR_CONFIG_PRESSURE_MS,
+		     STACK_SIZE, PRIORITY);
+SENSOR_WORKER_DEFINE(imu_worker, imu_sensor_sample_process, SENSOR_CONFIG_IMU_MS, STACK_SIZE,
+		     PRIORITY);
+SENSOR_WORKER_DEFINE(storage_worker, sensor_storage_work, SENSOR_CONFIG_STORAGE_MS,
+		     STORAGE_STACK_SIZE, STORAGE_PRIORITY);
+
+static struct sensor_worker *const sensor_workers[] = {
+	&hum_temp_worker,
+	&pressure_worker,
+	&imu_worker,
+	&storage_worker,
+};
 
 LOG_MODULE_REGISTER(main);
 
@@ -43,7 +56,21 @@ int main(void)
 {
 	int ret;
 
-	k_mutex_init(&sensor_data_mutex);
+	profiled_mutex_init(&sensor_data_mutex, "sensor_data_mutex");
+
+	/* Stored settings override the built-in defaults; failures leave the defaults in place */
+	sensor_config_init();
+
+	/* Workers are created once and stay parked until started from the shell */
+	for (int i = 0; i < ARRAY_SIZE(sensor_workers); i++) {
+		sensor_worker_init(sensor_workers[i]);
+	}
+
+	/* Telemetry is optional; the sensors and storage run without it */
+	ret = telemetry_init();
+	if (ret < 0) {
+		LOG_ERR("Telemetry init failed");
+	}
 
 	ret = hun_temp_sensor_init();
 	if (ret < 0) {
@@ -63,151 +90,374 @@ int main(void)
 		return ret;
 	}
 
+	sensor_config_apply_all();
+
 	return 0;
 }
 
-static void hun_temp_sensor_thread(void *a, void *b, void *c)
+static void sensor_storage_work(void)
 {
-	LOG_INF("Humidity-Temperature sensor thread started.");
-
-	while (!terminate_hum_temp_thread) {
-		hum_temp_sensor_process_sample();
-		k_sleep(SLEEP_TIME);
-	}
-
-	LOG_INF("Humidity-Temperature sensor thread stopped.");
+	profiled_mutex_lock(&sensor_data_mutex, K_FOREVER);
+	littlefs_save_sensor_data(&sensor_data);
+	profiled_mutex_unlock(&sensor_data_mutex);
 }
 
-static void pressure_sensor_thread(void *a, void *b, void *c)
+static int shell_worker_start(const struct shell *sh, struct sensor_worker *worker)
 {
-	LOG_INF("Pressure sensor thread started.");
-
-	while (!terminate_pressure_thread) {
-		pressure_sensor_process_sample();
-		k_sleep(SLEEP_TIME);
+	if (sensor_worker_start(worker) == -EALREADY) {
+		shell_print(sh, "%s already running", worker->name);
 	}
-
-	LOG_INF("Pressure sensor thread stopped.");
+	return 0;
 }
 
-static void imu_sensor_thread(void *a, void *b, void *c)
+static int shell_worker_stop(const struct shell *sh, struct sensor_worker *worker)
 {
-	LOG_INF("IMU sensor thread started.");
-
-	while (!terminate_imu_thread) {
-		imu_sensor_sample_process();
-		k_sleep(SLEEP_TIME);
+	if (sensor_worker_stop(worker) == -EALREADY) {
+		shell_print(sh, "%s already stopped", worker->name);
 	}
-
-	LOG_INF("IMU sensor thread stopped.");
+	return 0;
 }
 
 static int shell_start_hum_temp_thread(const struct shell *sh, size_t argc, char **argv, void *data)
 {
-	terminate_hum_temp_thread = false;
-	hum_temp_tid = k_thread_create(
-		&hum_temp_thread_data, hum_temp_stack, K_THREAD_STACK_SIZEOF(hum_temp_stack),
-		hun_temp_sensor_thread, NULL, NULL, NULL, PRIORITY, 0, K_NO_WAIT);
-	return 0;
+	return shell_worker_start(sh, &hum_temp_worker);
 }
 
 static int shell_start_pressure_thread(const struct shell *sh, size_t argc, char **argv, void *data)
 {
-	terminate_pressure_thread = false;
-	pressure_tid = k_thread_create(
-		&pressure_thread_data, pressure_stack, K_THREAD_STACK_SIZEOF(pressure_stack),
-		pressure_sensor_thread, NULL, NULL, NULL, PRIORITY, 0, K_NO_WAIT);
-	return 0;
+	return shell_worker_start(sh, &pressure_worker);
 }
 
 static int shell_start_imu_thread(const struct shell *sh, size_t argc, char **argv, void *data)
 {
-	terminate_imu_thread = false;
-	imu_tid = k_thread_create(&imu_thread_data, imu_stack, K_THREAD_STACK_SIZEOF(imu_stack),
-				  (void *)imu_sensor_thread, NULL, NULL, NULL, PRIORITY, 0,
-				  K_NO_WAIT);
-	return 0;
+	return shell_worker_start(sh, &imu_worker);
 }
 
 static int shell_start_all_sensors(const struct shell *sh, size_t argc, char **argv, void *data)
 {
-	terminate_hum_temp_thread = false;
-	terminate_pressure_thread = false;
-	terminate_imu_thread = false;
-
-	hum_temp_tid = k_thread_create(
-		&hum_temp_thread_data, hum_temp_stack, K_THREAD_STACK_SIZEOF(hum_temp_stack),
-		hun_temp_sensor_thread, NULL, NULL, NULL, PRIORITY, 0, K_NO_WAIT);
-	pressure_tid = k_thread_create(
-		&pressure_thread_data, pressure_stack, K_THREAD_STACK_SIZEOF(pressure_stack),
-		pressure_sensor_thread, NULL, NULL, NULL, PRIORITY, 0, K_NO_WAIT);
-	imu_tid = k_thread_create(&imu_thread_data, imu_stack, K_THREAD_STACK_SIZEOF(imu_stack),
-				  imu_sensor_thread, NULL, NULL, NULL, PRIORITY, 0, K_NO_WAIT);
+	shell_worker_start(sh, &hum_temp_worker);
+	shell_worker_start(sh, &pressure_worker);
+	shell_worker_start(sh, &imu_worker);
 	return 0;
 }
 
 static int shell_stop_hum_temp_thread(const struct shell *sh, size_t argc, char **argv)
 {
-	terminate_hum_temp_thread = true;
-	k_thread_join(hum_temp_tid, K_FOREVER);
-	return 0;
+	return shell_worker_stop(sh, &hum_temp_worker);
 }
 
 static int shell_stop_pressure_thread(const struct shell *sh, size_t argc, char **argv)
 {
-	terminate_pressure_thread = true;
-	k_thread_join(pressure_tid, K_FOREVER);
-	return 0;
+	return shell_worker_stop(sh, &pressure_worker);
 }
 
 static int shell_stop_imu_thread(const struct shell *sh, size_t argc, char **argv)
 {
-	terminate_imu_thread = true;
-	k_thread_join(imu_tid, K_FOREVER);
-	return 0;
+	return shell_worker_stop(sh, &imu_worker);
 }
 
 static int shell_stop_all_sensors(const struct shell *sh, size_t argc, char **argv)
 {
-	terminate_hum_temp_thread = true;
-	terminate_pressure_thread = true;
-	terminate_imu_thread = true;
+	shell_worker_stop(sh, &hum_temp_worker);
+	shell_worker_stop(sh, &pressure_worker);
+	shell_worker_stop(sh, &imu_worker);
+	return 0;
+}
+
+static int shell_start_storage_thread(const struct shell *sh, size_t argc, char **argv, void *data)
+{
+	return shell_worker_start(sh, &storage_worker);
+}
 
-	k_thread_join(hum_temp_tid, K_FOREVER);
-	k_thread_join(pressure_tid, K_FOREVER);
-	k_thread_join(imu_tid, K_FOREVER);
+static int shell_stop_storage_thread(const struct shell *sh, size_t argc, char **argv)
+{
+	return shell_worker_stop(sh, &storage_worker);
+}
 
+static int shell_status(const struct shell *sh, size_t argc, char **argv)
+{
+	for (int i = 0; i < ARRAY_SIZE(sensor_workers); i++) {
+		const struct sensor_worker *worker = sensor_workers[i];
+		const char *state = sensor_worker_is_running(worker)
+					    ? "running"
+					    : (sensor_worker_is_parked(worker) ? "stopped" : "stopping");
+
+		shell_print(sh, "%-16s %-8s period %u ms, iterations %u", worker->name, state,
+			    sensor_config_get(worker->period_key), worker->iterations);
+	}
 	return 0;
 }
 
-static void sensor_storage_thread(void *a, void *b, void *c)
+static int shell_profile(const struct shell *sh, size_t argc, char **argv)
 {
-	LOG_INF("Sensor storage thread started.");
+	char key[24];
+	int rc;
 
-	while (!terminate_storage_thread) {
-		k_mutex_lock(&sensor_data_mutex, K_FOREVER);
-		littlefs_save_sensor_data(&sensor_data);
-		k_mutex_unlock(&sensor_data_mutex);
+	if (argc == 1) {
+		shell_print(sh, "hts221: %s", sensor_profile_name(hum_temp_sensor_get_profile()));
+		shell_print(sh, "lps22hb: %s", sensor_profile_name(pressure_sensor_get_profile()));
+		return 0;
+	}
+
+	if (argc != 3 || (strcmp(argv[1], "hts221") != 0 && strcmp(argv[1], "lps22hb") != 0)) {
+		shell_error(sh, "usage: profile <hts221|lps22hb> <low_power|balanced|low_noise>");
+		return -EINVAL;
+	}
 
-		k_sleep(STORAGE_INTERVAL);
+	/* Goes through the settings store so the profile survives a reboot */
+	snprintf(key, sizeof(key), "%s_profile", argv[1]);
+	rc = sensor_config_set(key, argv[2]);
+	if (rc < 0) {
+		shell_error(sh, "failed to apply profile (%d)", rc);
+		return rc;
 	}
 
-	LOG_INF("Sensor storage thread stopped.");
+	shell_print(sh, "%s: %s", argv[1], argv[2]);
+	return 0;
 }
 
-static int shell_start_storage_thread(const struct shell *sh, size_t argc, char **argv, void *data)
+static int shell_config(const struct shell *sh, size_t argc, char **argv)
 {
-	terminate_storage_thread = false;
-	storage_tid = k_thread_create(&storage_thread_data, storage_stack,
-				      K_THREAD_STACK_SIZEOF(storage_stack), sensor_storage_thread,
-				      NULL, NULL, NULL, STORAGE_PRIORITY, 0, K_NO_WAIT);
+	char value[16];
+
+	for (int i = 0; i < SENSOR_CONFIG_COUNT; i++) {
+		sensor_config_format(i, value, sizeof(value));
+		shell_print(sh, "%-16s %s", sensor_config_name(i), value);
+	}
+
+	shell_print(sh, "boot load time: %u us", sensor_config_load_time_us());
 	return 0;
 }
 
-static int shell_stop_storage_thread(const struct shell *sh, size_t argc, char **argv)
+static int shell_set(const struct shell *sh, size_t argc, char **argv)
+{
+	int rc = sensor_config_set(argv[1], argv[2]);
+
+	if (rc == -ENOENT) {
+		shell_error(sh, "unknown key: %s (see 'sensor config')", argv[1]);
+		return rc;
+	}
+
+	if (rc == -EINVAL) {
+		shell_error(sh, "invalid value for %s: %s", argv[1], argv[2]);
+		return rc;
+	}
+
+	if (rc < 0) {
+		shell_error(sh, "failed to set %s (%d)", argv[1], rc);
+		return rc;
+	}
+
+	/* Wake running workers so a new period applies now rather than after the old one */
+	for (int i = 0; i < ARRAY_SIZE(sensor_workers); i++) {
+		sensor_worker_reschedule(sensor_workers[i]);
+	}
+
+	shell_print(sh, "%s = %s", argv[1], argv[2]);
+	return 0;
+}
+
+#ifdef CONFIG_PROFILED_MUTEX
+static void shell_locks_print(const struct profiled_mutex *pm, void *user_data)
+{
+	const struct shell *sh = user_data;
+	uint32_t acquisitions = pm->acquisitions;
+	uint32_t contended = pm->contended;
+
+	shell_print(sh, "%-20s %8u %8u %4u%% %8ld %9u %9u %9u %9u", pm->name, acquisitions,
+		    contended, acquisitions ? (contended * 100) / acquisitions : 0,
+		    atomic_get(&pm->timeouts),
+		    contended ? (uint32_t)k_cyc_to_us_ceil64(pm->wait_total / contended) : 0,
+		    (uint32_t)k_cyc_to_us_ceil64(pm->wait_max),
+		    acquisitions ? (uint32_t)k_cyc_to_us_ceil64(pm->hold_total / acquisitions) : 0,
+		    (uint32_t)k_cyc_to_us_ceil64(pm->hold_max));
+}
+#endif
+
+static int shell_locks(const struct shell *sh, size_t argc, char **argv)
+{
+#ifdef CONFIG_PROFILED_MUTEX
+	if (argc == 2 && strcmp(argv[1], "reset") == 0) {
+		profiled_mutex_reset_all();
+		shell_print(sh, "lock statistics cleared");
+		return 0;
+	}
+
+	if (argc != 1) {
+		shell_error(sh, "usage: locks [reset]");
+		return -EINVAL;
+	}
+
+	shell_print(sh, "%-20s %8s %8s %5s %8s %9s %9s %9s %9s", "mutex", "acquired", "waited", "",
+		    "timeouts", "wait avg", "wait max", "hold avg", "hold max");
+	profiled_mutex_foreach(shell_locks_print, (void *)sh);
+	shell_print(sh, "times in us; wait avg is over the acquisitions that waited");
+#endif
+	return 0;
+}
+
+static int shell_telemetry(const struct shell *sh, size_t argc, char **argv)
 {
-	terminate_storage_thread = true;
-	k_thread_join(storage_tid, K_FOREVER);
+#ifdef CONFIG_SENSOR_TELEMETRY
+	struct telemetry_stats stats;
+
+	if (argc == 2 && strcmp(argv[1], "reset") == 0) {
+		telemetry_reset_stats();
+		shell_print(sh, "telemetry statistics cleared");
+		return 0;
+	}
+
+	if (argc == 3 && strcmp(argv[1], "bench") == 0) {
+		uint32_t count = strtoul(argv[2], NULL, 10);
+		uint32_t queued;
+		int64_t start;
+		int64_t elapsed;
+
+		/* Sends as fast as the line drains; compare the rate with what the decoder sees */
+		telemetry_get_stats(&stats);
+		queued = stats.queued;
+		start = k_uptime_get();
+
+		for (uint32_t i = 0; i < count; i++) {
+			telemetry_send_bench(i);
+		}
+
+		if (telemetry_flush(1000) < 0) {
+			shell_warn(sh, "telemetry did not drain");
+		}
+
+		elapsed = MAX(k_uptime_get() - start, 1);
+		telemetry_get_stats(&stats);
+		queued = stats.queued - queued;
+
+		shell_print(sh, "%u packets, %u bytes in %u ms: %u packets/s, %u B/s (line %u B/s)",
+			    count, queued, (uint32_t)elapsed, (uint32_t)(count * 1000LL / elapsed),
+			    (uint32_t)(queued * 1000LL / elapsed), stats.baudrate / 10);
+		return 0;
+	}
+
+	if (argc != 1) {
+		shell_error(sh, "usage: telemetry [reset | bench <packets>]");
+		return -EINVAL;
+	}
+
+	telemetry_get_stats(&stats);
+	shell_print(sh, "baudrate   %u", stats.baudrate);
+	shell_print(sh, "packets    %u", stats.packets);
+	shell_print(sh, "dropped    %u", stats.dropped);
+	shell_print(sh, "queued     %u B", stats.queued);
+	shell_print(sh, "sent       %u B", stats.sent);
+	shell_print(sh, "high water %u / %u B", stats.high_water, CONFIG_SENSOR_TELEMETRY_BUF_SIZE);
+#endif
+	return 0;
+}
+
+struct log_bench_cycles {
+	const char *name;
+	uint32_t total;
+	uint32_t max;
+};
+
+static void log_bench_record(struct log_bench_cycles *cycles, uint32_t start)
+{
+	uint32_t elapsed = k_cycle_get_32() - start;
+
+	cycles->total += elapsed;
+	cycles->max = MAX(cycles->max, elapsed);
+}
+
+/* Waits for the log thread to empty the buffer, adding the time taken to drain_ms */
+static bool log_bench_drain(uint32_t *drain_ms)
+{
+	int64_t start = k_uptime_get();
+
+	while (log_data_pending() && k_uptime_get() - start < LOG_BENCH_DRAIN_MS) {
+		k_msleep(1);
+	}
+
+	*drain_ms += (uint32_t)(k_uptime_get() - start);
+	return !log_data_pending();
+}
+
+/*
+ * Times each reading message of the sensor modules with fixed values. In deferred mode a call
+ * only packages the format string pointer and the arguments; the drain time is what the log
+ * thread then needs to format (text output) or copy out (dictionary output) the messages.
+ *
+ * The loop never yields, so the log thread cannot drain while it runs. Messages are therefore
+ * issued in batches that fill at most half of CONFIG_LOG_BUFFER_SIZE, and each batch is
+ * drained before the next one; otherwise the buffer would overflow and the timings would
+ * include the overflow path.
+ */
+static int shell_logbench(const struct shell *sh, size_t argc, char **argv)
+{
+	struct log_bench_cycles cycles[] = {
+		{"temperature"}, {"humidity"}, {"pressure"}, {"accel"}, {"gyro"},
+	};
+	int count = argc > 1 ? CLAMP(atoi(argv[1]), 1, LOG_BENCH_MAX_COUNT) : 20;
+	int batch = MAX(CONFIG_LOG_BUFFER_SIZE / 2 / (ARRAY_SIZE(cycles) * LOG_BENCH_MSG_SIZE), 1);
+	uint32_t buf_size = 0;
+	uint32_t peak = 0;
+	uint32_t drain_ms = 0;
+	uint32_t used;
+	uint32_t start;
+	bool drained;
+	int done = 0;
+
+	/* Start from an empty buffer so the drain time only covers this run */
+	if (!log_bench_drain(&drain_ms)) {
+		shell_error(sh, "log buffer does not drain");
+		return -EBUSY;
+	}
+	drain_ms = 0;
+
+	do {
+		for (int i = 0; i < batch && done < count; i++, done++) {
+			start = k_cycle_get_32();
+			LOG_INF("Temperature:%.1f C", 23.4);
+			log_bench_record(&cycles[0], start);
+
+			start = k_cycle_get_32();
+			LOG_INF("Relative Humidity:%.1f%%", 45.6);
+			log_bench_record(&cycles[1], start);
+
+			start = k_cycle_get_32();
+			LOG_INF("Pressure:%.1f kPa", 101.3);
+			log_bench_record(&cycles[2], start);
+
+			start = k_cycle_get_32();
+			LOG_INF("accel x:%.3f y:%.3f z:%.3f m/s^2", 0.123, -0.045, 9.806);
+			log_bench_record(&cycles[3], start);
+
+			start = k_cycle_get_32();
+			LOG_INF("gyro x:%.3f y:%.3f z:%.3f rad/s", 0.012, -0.021, 0.003);
+			log_bench_record(&cycles[4], start);
+		}
+
+		/* Fill level before the log thread gets to run */
+		if (log_mem_get_usage(&buf_size, &used) == 0) {
+			peak = MAX(peak, used);
+		}
+		drained = log_bench_drain(&drain_ms);
+	} while (drained && done < count);
+
+	shell_print(sh, "%-12s %10s %10s %10s", "message", "avg cyc", "max cyc", "avg ns");
+	for (int i = 0; i < ARRAY_SIZE(cycles); i++) {
+		uint32_t avg = cycles[i].total / done;
+
+		shell_print(sh, "%-12s %10u %10u %10u", cycles[i].name, avg, cycles[i].max,
+			    (uint32_t)k_cyc_to_ns_floor64(avg));
+	}
+	shell_print(sh, "%d messages in batches of %d drained in %u ms%s",
+		    done * (int)ARRAY_SIZE(cycles), batch * (int)ARRAY_SIZE(cycles), drain_ms,
+		    drained ? "" : " (still pending)");
+	if (buf_size > 0) {
+		bool full = peak + LOG_BENCH_MSG_SIZE > buf_size;
+
+		/* The log thread reports the count as "--- N messages dropped ---" */
+		shell_print(sh, "log buffer peak %u of %u B%s", peak, buf_size,
+			    full ? ", full: messages may have been dropped" : "");
+	}
 	return 0;
 }
 
@@ -223,6 +473,22 @@ SHELL_STATIC_SUBCMD_SET_CREATE(
 	SHELL_CMD(stop, NULL, "Stop all sensor thread", shell_stop_all_sensors),
 	SHELL_CMD(start_storage, NULL, "Start sensor storage thread", shell_start_storage_thread),
 	SHELL_CMD(stop_storage, NULL, "Stop sensor storage thread", shell_stop_storage_thread),
+	SHELL_CMD_ARG(profile, NULL,
+		      "Show or set noise/power profile: profile [<hts221|lps22hb> "
+		      "<low_power|balanced|low_noise>]",
+		      shell_profile, 1, 2),
+	SHELL_CMD(status, NULL, "Show sensor and storage worker state", shell_status),
+	SHELL_CMD(config, NULL, "Show runtime settings", shell_config),
+	SHELL_CMD_ARG(set, NULL, "Set and persist a runtime setting: set <key> <value>", shell_set,
+		      3, 0),
+	SHELL_COND_CMD_ARG(CONFIG_PROFILED_MUTEX, locks, NULL,
+			   "Show mutex contention statistics: locks [reset]", shell_locks, 1, 1),
+	SHELL_COND_CMD_ARG(CONFIG_SENSOR_TELEMETRY, telemetry, NULL,
+			   "Show telemetry statistics: telemetry [reset | bench <packets>]",
+			   shell_telemetry, 1, 2),
+	SHELL_CMD_ARG(logbench, NULL,
+		      "Time the sensor log messages: logbench [count], count up to 200",
+		      shell_logbench, 1, 1),
 	SHELL_SUBCMD_SET_END);
 /* Creating root (level 0) command "demo" */
 SHELL_CMD_REGISTER(sensor, &sub_demo, "Sensor Demo commands", NULL);
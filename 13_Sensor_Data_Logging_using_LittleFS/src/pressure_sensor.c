@@ -1,9 +1,12 @@
 #include "pressure_sensor.h"
 #include "sensor_shared.h"
+#include "telemetry.h"
 
 #include <zephyr/device.h>
+#include <zephyr/drivers/i2c.h>
 #include <zephyr/drivers/sensor.h>
 #include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
 #include <zephyr/sys/util.h>
 
 #include <zephyr/logging/log.h>
@@ -13,10 +16,237 @@ LOG_MODULE_REGISTER(pressure);
 #if DT_NODE_EXISTS(DT_ALIAS(pressure_sensor))
 #define PRESSURE_NODE DT_ALIAS(pressure_sensor)
 const struct device *const pressure_dev = DEVICE_DT_GET(DT_ALIAS(pressure_sensor));
+static const struct i2c_dt_spec pressure_bus = I2C_DT_SPEC_GET(PRESSURE_NODE);
 #else
 #error ("Pressure sensor not found.");
 #endif
 
+/* Low-rate logging: keep the sensor powered down between samples */
+#define PRESSURE_DEFAULT_MODE PRESSURE_MODE_ONE_SHOT
+
+/* Keeps the ODR/20 filter the FIFO path was tuned with */
+#define PRESSURE_DEFAULT_PROFILE SENSOR_PROFILE_LOW_NOISE
+
+#define PRESSURE_FIFO_DEPTH 32
+
+#define PRESSURE_ONE_SHOT_POLL_TIME K_MSEC(5)
+#define PRESSURE_ONE_SHOT_RETRIES   20
+
+#define LPS22HB_REG_CTRL_REG1    0x10
+#define LPS22HB_REG_CTRL_REG2    0x11
+#define LPS22HB_REG_FIFO_CTRL    0x14
+#define LPS22HB_REG_FIFO_STATUS  0x26
+#define LPS22HB_REG_RES_CONF     0x1A
+#define LPS22HB_REG_STATUS       0x27
+#define LPS22HB_REG_PRESS_OUT_XL 0x28
+
+#define LPS22HB_ODR_SHIFT          4
+#define LPS22HB_ODR_POWER_DOWN     0
+#define LPS22HB_ODR_1HZ            1
+#define LPS22HB_ODR_10HZ           2
+#define LPS22HB_ODR_25HZ           3
+#define LPS22HB_CTRL_REG1_ODR_MASK (7 << LPS22HB_ODR_SHIFT)
+#define LPS22HB_CTRL_REG1_EN_LPFP  BIT(3)
+#define LPS22HB_CTRL_REG1_LPFP_CFG BIT(2)
+#define LPS22HB_CTRL_REG1_BDU      BIT(1)
+#define LPS22HB_CTRL_REG2_FIFO_EN  BIT(6)
+#define LPS22HB_CTRL_REG2_ADD_INC  BIT(4)
+#define LPS22HB_CTRL_REG2_ONE_SHOT BIT(0)
+#define LPS22HB_FIFO_MODE_BYPASS   (0 << 5)
+#define LPS22HB_FIFO_MODE_STREAM   (2 << 5)
+#define LPS22HB_FIFO_STATUS_FSS    0x3F
+#define LPS22HB_STATUS_P_DA        BIT(0)
+#define LPS22HB_RES_CONF_LC_EN     BIT(0)
+
+/* ODR the driver programs at init, restored in continuous mode */
+#if CONFIG_LPS22HB_SAMPLING_RATE == 1
+#define LPS22HB_ODR_DRIVER 1
+#elif CONFIG_LPS22HB_SAMPLING_RATE == 10
+#define LPS22HB_ODR_DRIVER 2
+#elif CONFIG_LPS22HB_SAMPLING_RATE == 50
+#define LPS22HB_ODR_DRIVER 4
+#elif CONFIG_LPS22HB_SAMPLING_RATE == 75
+#define LPS22HB_ODR_DRIVER 5
+#else
+#define LPS22HB_ODR_DRIVER 3
+#endif
+
+/* PRESS_OUT_XL/L/H + TEMP_OUT_L/H */
+#define LPS22HB_FIFO_SLOT_SIZE 5
+
+/* 4096 LSB/hPa, reported in kPa like SENSOR_CHAN_PRESS */
+#define LPS22HB_LSB_PER_KPA 40960.0
+
+struct lps22hb_profile {
+    uint8_t odr;      /* ODR used in FIFO mode */
+    uint8_t lpf;      /* EN_LPFP / LPFP_CFG bits of CTRL_REG1, FIFO mode only */
+    uint8_t res_conf; /* LC_EN: low-current mode trades noise for supply current */
+};
+
+static const struct lps22hb_profile lps_profiles[SENSOR_PROFILE_COUNT] = {
+    [SENSOR_PROFILE_LOW_POWER] = {
+        .odr = LPS22HB_ODR_1HZ,
+        .lpf = 0,
+        .res_conf = LPS22HB_RES_CONF_LC_EN,
+    },
+    /* low-pass at ODR/9 */
+    [SENSOR_PROFILE_BALANCED] = {
+        .odr = LPS22HB_ODR_10HZ,
+        .lpf = LPS22HB_CTRL_REG1_EN_LPFP,
+        .res_conf = 0,
+    },
+    /* low-pass at ODR/20 */
+    [SENSOR_PROFILE_LOW_NOISE] = {
+        .odr = LPS22HB_ODR_25HZ,
+        .lpf = LPS22HB_CTRL_REG1_EN_LPFP | LPS22HB_CTRL_REG1_LPFP_CFG,
+        .res_conf = 0,
+    },
+};
+
+static enum pressure_mode pressure_mode = PRESSURE_MODE_CONTINUOUS;
+static enum sensor_profile pressure_profile = PRESSURE_DEFAULT_PROFILE;
+
+/* Serialises reconfiguration from the shell against the sampling thread */
+static PROFILED_MUTEX_DEFINE(pressure_cfg_mutex);
+
+static double pressure_raw_to_kpa(const uint8_t *raw)
+{
+    /* sign-extend the 24-bit two's complement sample */
+    int32_t value = ((int32_t)(sys_get_le24(raw) << 8)) >> 8;
+
+    return value / LPS22HB_LSB_PER_KPA;
+}
+
+static int pressure_apply_config(enum pressure_mode mode, enum sensor_profile profile)
+{
+    const struct lps22hb_profile *cfg = &lps_profiles[profile];
+    uint8_t ctrl1 = LPS22HB_CTRL_REG1_BDU;
+    uint8_t ctrl2 = LPS22HB_CTRL_REG2_ADD_INC;
+    uint8_t fifo_ctrl = LPS22HB_FIFO_MODE_BYPASS;
+
+    if (mode == PRESSURE_MODE_FIFO) {
+        /*
+         * stream mode keeps the newest 32 filtered samples; one-shot and continuous stay
+         * unfiltered as before the profiles existed
+         */
+        ctrl1 |= (cfg->odr << LPS22HB_ODR_SHIFT) | cfg->lpf;
+        ctrl2 |= LPS22HB_CTRL_REG2_FIFO_EN;
+        fifo_ctrl = LPS22HB_FIFO_MODE_STREAM;
+    } else if (mode == PRESSURE_MODE_CONTINUOUS) {
+        /* back to the driver's rate; FIFO_EN and FIFO_CTRL are cleared below */
+        ctrl1 |= LPS22HB_ODR_DRIVER << LPS22HB_ODR_SHIFT;
+    } else {
+        ctrl1 |= LPS22HB_ODR_POWER_DOWN << LPS22HB_ODR_SHIFT;
+    }
+
+    /*
+     * power down first so the FIFO restarts with the new configuration; LC_EN may only be
+     * changed while powered down
+     */
+    if (i2c_reg_write_byte_dt(&pressure_bus, LPS22HB_REG_CTRL_REG1, LPS22HB_CTRL_REG1_BDU) < 0 ||
+        i2c_reg_write_byte_dt(&pressure_bus, LPS22HB_REG_RES_CONF, cfg->res_conf) < 0 ||
+        i2c_reg_write_byte_dt(&pressure_bus, LPS22HB_REG_FIFO_CTRL, fifo_ctrl) < 0 ||
+        i2c_reg_write_byte_dt(&pressure_bus, LPS22HB_REG_CTRL_REG2, ctrl2) < 0 ||
+        i2c_reg_write_byte_dt(&pressure_bus, LPS22HB_REG_CTRL_REG1, ctrl1) < 0) {
+        return -EIO;
+    }
+
+    return 0;
+}
+
+int pressure_sensor_set_mode(enum pressure_mode mode)
+{
+    profiled_mutex_lock(&pressure_cfg_mutex, K_FOREVER);
+    int rc = pressure_apply_config(mode, pressure_profile);
+    if (rc == 0) {
+        pressure_mode = mode;
+    }
+    profiled_mutex_unlock(&pressure_cfg_mutex);
+
+    if (rc < 0) {
+        LOG_ERR("Cannot configure pressure mode %d (%d)", mode, rc);
+    }
+    return rc;
+}
+
+int pressure_sensor_set_profile(enum sensor_profile profile)
+{
+    if (profile >= SENSOR_PROFILE_COUNT) {
+        return -EINVAL;
+    }
+
+    profiled_mutex_lock(&pressure_cfg_mutex, K_FOREVER);
+    int rc = pressure_apply_config(pressure_mode, profile);
+    if (rc == 0) {
+        pressure_profile = profile;
+    }
+    profiled_mutex_unlock(&pressure_cfg_mutex);
+
+    if (rc < 0) {
+        LOG_ERR("Cannot apply pressure profile %s (%d)", sensor_profile_name(profile), rc);
+    }
+    return rc;
+}
+
+enum sensor_profile pressure_sensor_get_profile(void)
+{
+    return pressure_profile;
+}
+
+static int pressure_read_one_shot(double *kpa)
+{
+    uint8_t status = 0;
+    uint8_t raw[3];
+
+    if (i2c_reg_write_byte_dt(&pressure_bus, LPS22HB_REG_CTRL_REG2,
+                              LPS22HB_CTRL_REG2_ADD_INC | LPS22HB_CTRL_REG2_ONE_SHOT) < 0) {
+        return -EIO;
+    }
+
+    for (int i = 0; i < PRESSURE_ONE_SHOT_RETRIES && !(status & LPS22HB_STATUS_P_DA); i++) {
+        k_sleep(PRESSURE_ONE_SHOT_POLL_TIME);
+        if (i2c_reg_read_byte_dt(&pressure_bus, LPS22HB_REG_STATUS, &status) < 0) {
+            return -EIO;
+        }
+    }
+
+    if (!(status & LPS22HB_STATUS_P_DA)) {
+        return -ETIMEDOUT;
+    }
+
+    if (i2c_burst_read_dt(&pressure_bus, LPS22HB_REG_PRESS_OUT_XL, raw, sizeof(raw)) < 0) {
+        return -EIO;
+    }
+
+    *kpa = pressure_raw_to_kpa(raw);
+    return 0;
+}
+
+/* Drain the whole FIFO with one burst; the output address wraps from TEMP_OUT_H back to
+ * PRESS_OUT_XL while the FIFO is enabled. Fills raw oldest slot first and returns the number
+ * of slots read.
+ */
+static int pressure_read_fifo(uint8_t raw[PRESSURE_FIFO_DEPTH * LPS22HB_FIFO_SLOT_SIZE])
+{
+    uint8_t fifo_status;
+    int level;
+
+    if (i2c_reg_read_byte_dt(&pressure_bus, LPS22HB_REG_FIFO_STATUS, &fifo_status) < 0) {
+        return -EIO;
+    }
+
+    level = MIN(fifo_status & LPS22HB_FIFO_STATUS_FSS, PRESSURE_FIFO_DEPTH);
+    if (level == 0) {
+        return -EAGAIN;
+    }
+
+    if (i2c_burst_read_dt(&pressure_bus, LPS22HB_REG_PRESS_OUT_XL, raw, level * LPS22HB_FIFO_SLOT_SIZE) < 0) {
+        return -EIO;
+    }
+
+    return level;
+}
+
 void pressure_sensor_process_sample(void)
 {
     if (!device_is_ready(pressure_dev)) {
@@ -24,23 +254,59 @@ void pressure_sensor_process_sample(void)
         return;
     }
 
-    if (sensor_sample_fetch(pressure_dev) < 0) {
-        LOG_INF("Sensor sample update error");
-        return;
+    uint8_t raw[PRESSURE_FIFO_DEPTH * LPS22HB_FIFO_SLOT_SIZE];
+    const uint8_t *fifo = NULL;
+    double kpa = 0.0;
+    int count = 1;
+    int rc;
+
+    profiled_mutex_lock(&pressure_cfg_mutex, K_FOREVER);
+    switch (pressure_mode) {
+    case PRESSURE_MODE_ONE_SHOT:
+        rc = pressure_read_one_shot(&kpa);
+        break;
+    case PRESSURE_MODE_FIFO:
+        rc = pressure_read_fifo(raw);
+        fifo = raw;
+        count = rc;
+        break;
+    default: {
+        struct sensor_value pressure;
+
+        rc = sensor_sample_fetch(pressure_dev);
+        if (rc == 0) {
+            rc = sensor_channel_get(pressure_dev, SENSOR_CHAN_PRESS, &pressure);
+            kpa = sensor_value_to_double(&pressure);
+        }
+        break;
+    }
     }
+    profiled_mutex_unlock(&pressure_cfg_mutex);
 
-    struct sensor_value pressure;
-    if (sensor_channel_get(pressure_dev, SENSOR_CHAN_PRESS, &pressure) < 0) {
-        LOG_ERR("Cannot read pressure channel");
+    if (rc < 0) {
+        LOG_ERR("Cannot read pressure channel (%d)", rc);
         return;
     }
 
-    k_mutex_lock(&sensor_data_mutex, K_FOREVER);
-    sensor_data.pressure = sensor_value_to_double(&pressure);
-    k_mutex_unlock(&sensor_data_mutex);
+    /* every FIFO slot goes out as its own packet, oldest first */
+    for (int i = 0; i < count; i++) {
+        if (fifo != NULL) {
+            kpa = pressure_raw_to_kpa(&fifo[i * LPS22HB_FIFO_SLOT_SIZE]);
+        }
+        telemetry_send_pressure(kpa);
+    }
+
+    /* the storage snapshot keeps the newest sample */
+    profiled_mutex_lock(&sensor_data_mutex, K_FOREVER);
+    sensor_data.pressure = kpa;
+    profiled_mutex_unlock(&sensor_data_mutex);
+
+    if (!IS_ENABLED(CONFIG_SENSOR_LOG_READINGS)) {
+        return;
+    }
 
     /* display pressure */
-    LOG_INF("Pressure:%.1f kPa", sensor_value_to_double(&pressure));
+    LOG_INF("Pressure:%.1f kPa", kpa);
 }
 
 int pressure_sensor_init(void)
@@ -50,6 +316,10 @@ int pressure_sensor_init(void)
         return -1;
     }
 
+    if (pressure_sensor_set_mode(PRESSURE_DEFAULT_MODE) < 0) {
+        LOG_WRN("Falling back to continuous pressure acquisition");
+    }
+
     pressure_sensor_process_sample();
 
     return 0;
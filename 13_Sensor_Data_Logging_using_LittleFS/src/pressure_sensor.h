@@ -1,7 +1,22 @@
 #ifndef PRESSURE_SENSOR_H
 #define PRESSURE_SENSOR_H
 
+#include "sensor_shared.h"
+
+enum pressure_mode {
+    /* Sensor free-runs at the driver ODR, one fetch per wakeup */
+    PRESSURE_MODE_CONTINUOUS,
+    /* Sensor powered down between wakeups, one conversion per wakeup */
+    PRESSURE_MODE_ONE_SHOT,
+    /* Sensor runs with the low-pass filter into its FIFO, one burst read per wakeup; every
+     * drained sample is sent as telemetry, the storage snapshot keeps the newest */
+    PRESSURE_MODE_FIFO,
+};
+
 void pressure_sensor_process_sample(void);
+int pressure_sensor_set_mode(enum pressure_mode mode);
+int pressure_sensor_set_profile(enum sensor_profile profile);
+enum sensor_profile pressure_sensor_get_profile(void);
 int pressure_sensor_init(void);
 
 #endif /* PRESSURE_SENSOR_H */
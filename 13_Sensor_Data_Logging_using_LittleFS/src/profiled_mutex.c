@@ -0,0 +1,109 @@
+#include "profiled_mutex.h"
+
+#ifdef CONFIG_PROFILED_MUTEX
+
+static sys_slist_t profiled_mutexes = SYS_SLIST_STATIC_INIT(&profiled_mutexes);
+static struct k_spinlock registry_lock;
+
+static void profiled_mutex_register(struct profiled_mutex *pm)
+{
+    k_spinlock_key_t key = k_spin_lock(&registry_lock);
+
+    if (!pm->registered) {
+        sys_slist_append(&profiled_mutexes, &pm->node);
+        pm->registered = true;
+    }
+
+    k_spin_unlock(&registry_lock, key);
+}
+
+void profiled_mutex_init(struct profiled_mutex *pm, const char *name)
+{
+    k_mutex_init(&pm->mutex);
+    pm->name = name;
+    profiled_mutex_register(pm);
+}
+
+int profiled_mutex_lock(struct profiled_mutex *pm, k_timeout_t timeout)
+{
+    uint32_t start = k_cycle_get_32();
+    bool contended = false;
+    int ret;
+
+    /* Statically defined mutexes join the registry on first use */
+    if (!pm->registered) {
+        profiled_mutex_register(pm);
+    }
+
+    ret = k_mutex_lock(&pm->mutex, K_NO_WAIT);
+    if (ret == -EBUSY && !K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+        contended = true;
+        ret = k_mutex_lock(&pm->mutex, timeout);
+    }
+
+    if (ret != 0) {
+        atomic_inc(&pm->timeouts);
+        return ret;
+    }
+
+    /* Nested locks by the owner are not new acquisitions */
+    if (pm->mutex.lock_count > 1) {
+        return 0;
+    }
+
+    uint32_t now = k_cycle_get_32();
+
+    pm->acquisitions++;
+    if (contended) {
+        uint32_t waited = now - start;
+
+        pm->contended++;
+        pm->wait_total += waited;
+        pm->wait_max = MAX(pm->wait_max, waited);
+    }
+    pm->locked_at = now;
+
+    return 0;
+}
+
+int profiled_mutex_unlock(struct profiled_mutex *pm)
+{
+    if (pm->mutex.owner == k_current_get() && pm->mutex.lock_count == 1) {
+        uint32_t held = k_cycle_get_32() - pm->locked_at;
+
+        pm->hold_total += held;
+        pm->hold_max = MAX(pm->hold_max, held);
+    }
+
+    return k_mutex_unlock(&pm->mutex);
+}
+
+void profiled_mutex_foreach(void (*cb)(const struct profiled_mutex *pm, void *user_data),
+                            void *user_data)
+{
+    struct profiled_mutex *pm;
+
+    /* Mutexes are only ever appended, so the list can be walked without the lock */
+    SYS_SLIST_FOR_EACH_CONTAINER(&profiled_mutexes, pm, node) {
+        cb(pm, user_data);
+    }
+}
+
+void profiled_mutex_reset_all(void)
+{
+    struct profiled_mutex *pm;
+
+    SYS_SLIST_FOR_EACH_CONTAINER(&profiled_mutexes, pm, node) {
+        k_mutex_lock(&pm->mutex, K_FOREVER);
+        pm->acquisitions = 0;
+        pm->contended = 0;
+        atomic_clear(&pm->timeouts);
+        pm->wait_total = 0;
+        pm->wait_max = 0;
+        pm->hold_total = 0;
+        pm->hold_max = 0;
+        k_mutex_unlock(&pm->mutex);
+    }
+}
+
+#endif /* CONFIG_PROFILED_MUTEX */
@@ -0,0 +1,78 @@
+#ifndef PROFILED_MUTEX_H
+#define PROFILED_MUTEX_H
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/slist.h>
+
+/*
+ * k_mutex with contention statistics, used in place of k_mutex_lock/unlock.
+ * Counts acquisitions, acquisitions that had to wait, failed (timed out) locks, and the
+ * total/max time spent waiting for and holding the lock. The statistics are updated while
+ * the mutex is held, so they need no lock of their own. Only the outermost lock of a
+ * recursive acquisition is counted.
+ *
+ * With CONFIG_PROFILED_MUTEX=n the structure is a bare k_mutex and the lock calls inline
+ * to k_mutex_lock/unlock.
+ */
+struct profiled_mutex {
+    struct k_mutex mutex;
+#ifdef CONFIG_PROFILED_MUTEX
+    const char *name;
+    sys_snode_t node;
+    bool registered;
+    uint32_t locked_at;
+
+    uint32_t acquisitions;
+    uint32_t contended;
+    atomic_t timeouts;
+    uint64_t wait_total;
+    uint32_t wait_max;
+    uint64_t hold_total;
+    uint32_t hold_max;
+#endif
+};
+
+#ifdef CONFIG_PROFILED_MUTEX
+
+#define PROFILED_MUTEX_DEFINE(_name)                                                               \
+    struct profiled_mutex _name = {                                                                \
+        .mutex = Z_MUTEX_INITIALIZER(_name.mutex),                                                 \
+        .name = #_name,                                                                            \
+    }
+
+void profiled_mutex_init(struct profiled_mutex *pm, const char *name);
+int profiled_mutex_lock(struct profiled_mutex *pm, k_timeout_t timeout);
+int profiled_mutex_unlock(struct profiled_mutex *pm);
+
+/* Calls cb for every profiled mutex that was initialized or locked at least once */
+void profiled_mutex_foreach(void (*cb)(const struct profiled_mutex *pm, void *user_data),
+                            void *user_data);
+void profiled_mutex_reset_all(void);
+
+#else
+
+#define PROFILED_MUTEX_DEFINE(_name)                                                               \
+    struct profiled_mutex _name = {                                                                \
+        .mutex = Z_MUTEX_INITIALIZER(_name.mutex),                                                 \
+    }
+
+static inline void profiled_mutex_init(struct profiled_mutex *pm, const char *name)
+{
+    ARG_UNUSED(name);
+    k_mutex_init(&pm->mutex);
+}
+
+static inline int profiled_mutex_lock(struct profiled_mutex *pm, k_timeout_t timeout)
+{
+    return k_mutex_lock(&pm->mutex, timeout);
+}
+
+static inline int profiled_mutex_unlock(struct profiled_mutex *pm)
+{
+    return k_mutex_unlock(&pm->mutex);
+}
+
+#endif /* CONFIG_PROFILED_MUTEX */
+
+#endif /* PROFILED_MUTEX_H */
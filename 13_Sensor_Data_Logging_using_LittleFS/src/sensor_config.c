@@ -0,0 +1,257 @@
+#include "sensor_config.h"
+#include "hum_temp_sensor.h"
+#include "pressure_sensor.h"
+#include "sensor_shared.h"
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/settings/settings.h>
+#include <zephyr/sys/util.h>
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+LOG_MODULE_REGISTER(sensor_config);
+
+#define SENSOR_CONFIG_SUBTREE "sensor"
+
+/* Boot-time load budget; the load is a single pass over a few NVS sectors
+ * (CONFIG_SETTINGS_NVS_SECTOR_COUNT), so exceeding this points at a worn or corrupt store.
+ */
+#define SENSOR_CONFIG_LOAD_BUDGET_US 20000
+
+static const char *const pressure_mode_names[] = {
+    [PRESSURE_MODE_CONTINUOUS] = "continuous",
+    [PRESSURE_MODE_ONE_SHOT] = "one_shot",
+    [PRESSURE_MODE_FIFO] = "fifo",
+};
+
+struct sensor_config_desc {
+    const char *name;
+    uint32_t def;
+    uint32_t min;
+    uint32_t max;
+    /* Symbolic value names, NULL for plain numbers */
+    const char *const *value_names;
+    int (*apply)(uint32_t value);
+};
+
+static int apply_hts221_profile(uint32_t value)
+{
+    return hum_temp_sensor_set_profile(value);
+}
+
+static int apply_lps22hb_profile(uint32_t value)
+{
+    return pressure_sensor_set_profile(value);
+}
+
+static int apply_lps22hb_mode(uint32_t value)
+{
+    return pressure_sensor_set_mode(value);
+}
+
+static const struct sensor_config_desc config_desc[SENSOR_CONFIG_COUNT] = {
+    /* Periods are read by the threads on every iteration, so they need no apply hook */
+    [SENSOR_CONFIG_HUM_TEMP_MS] = {"hum_temp_ms", 5000, 100, 3600000, NULL, NULL},
+    [SENSOR_CONFIG_PRESSURE_MS] = {"pressure_ms", 5000, 100, 3600000, NULL, NULL},
+    [SENSOR_CONFIG_IMU_MS] = {"imu_ms", 5000, 10, 3600000, NULL, NULL},
+    [SENSOR_CONFIG_STORAGE_MS] = {"storage_ms", 60000, 1000, 86400000, NULL, NULL},
+    [SENSOR_CONFIG_HTS221_PROFILE] = {"hts221_profile", SENSOR_PROFILE_BALANCED, 0,
+                                      SENSOR_PROFILE_COUNT - 1, sensor_profile_names,
+                                      apply_hts221_profile},
+    [SENSOR_CONFIG_LPS22HB_PROFILE] = {"lps22hb_profile", SENSOR_PROFILE_LOW_NOISE, 0,
+                                       SENSOR_PROFILE_COUNT - 1, sensor_profile_names,
+                                       apply_lps22hb_profile},
+    [SENSOR_CONFIG_LPS22HB_MODE] = {"lps22hb_mode", PRESSURE_MODE_ONE_SHOT, 0,
+                                    ARRAY_SIZE(pressure_mode_names) - 1, pressure_mode_names,
+                                    apply_lps22hb_mode},
+};
+
+/* Current values; read lock-free by the sampling threads */
+static atomic_t config_values[SENSOR_CONFIG_COUNT];
+
+static uint32_t config_load_us;
+static bool config_store_ready;
+
+static int config_find(const char *name, size_t len)
+{
+    for (int i = 0; i < SENSOR_CONFIG_COUNT; i++) {
+        if (strlen(config_desc[i].name) == len && strncmp(name, config_desc[i].name, len) == 0) {
+            return i;
+        }
+    }
+
+    return -ENOENT;
+}
+
+static int config_settings_set(const char *name, size_t len, settings_read_cb read_cb,
+                               void *cb_arg)
+{
+    const char *next;
+    uint32_t value;
+
+    int key = config_find(name, settings_name_next(name, &next));
+    if (key < 0 || next != NULL) {
+        /* Unknown or removed key: ignore rather than fail the whole load */
+        return 0;
+    }
+
+    if (len != sizeof(value) || read_cb(cb_arg, &value, sizeof(value)) != sizeof(value)) {
+        return -EINVAL;
+    }
+
+    if (value < config_desc[key].min || value > config_desc[key].max) {
+        LOG_WRN("Stored %s=%u out of range, keeping default", config_desc[key].name, value);
+        return 0;
+    }
+
+    atomic_set(&config_values[key], value);
+    return 0;
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE(sensor_config, SENSOR_CONFIG_SUBTREE, NULL, config_settings_set,
+                               NULL, NULL);
+
+int sensor_config_init(void)
+{
+    for (int i = 0; i < SENSOR_CONFIG_COUNT; i++) {
+        atomic_set(&config_values[i], config_desc[i].def);
+    }
+
+    uint32_t start = k_cycle_get_32();
+
+    int rc = settings_subsys_init();
+    if (rc == 0) {
+        /* One pass over the backend; every stored key lands in config_settings_set() */
+        rc = settings_load_subtree(SENSOR_CONFIG_SUBTREE);
+    }
+
+    config_load_us = k_cyc_to_us_floor32(k_cycle_get_32() - start);
+
+    if (rc < 0) {
+        LOG_ERR("Settings load failed (%d), using defaults", rc);
+        return rc;
+    }
+
+    config_store_ready = true;
+
+    if (config_load_us > SENSOR_CONFIG_LOAD_BUDGET_US) {
+        LOG_WRN("Settings load took %u us (budget %u us)", config_load_us,
+                SENSOR_CONFIG_LOAD_BUDGET_US);
+    } else {
+        LOG_INF("Settings loaded in %u us", config_load_us);
+    }
+
+    return 0;
+}
+
+int sensor_config_apply_all(void)
+{
+    int ret = 0;
+
+    for (int i = 0; i < SENSOR_CONFIG_COUNT; i++) {
+        if (config_desc[i].apply == NULL) {
+            continue;
+        }
+
+        int rc = config_desc[i].apply(atomic_get(&config_values[i]));
+        if (rc < 0) {
+            LOG_ERR("Cannot apply %s (%d)", config_desc[i].name, rc);
+            ret = rc;
+        }
+    }
+
+    return ret;
+}
+
+uint32_t sensor_config_get(enum sensor_config_key key)
+{
+    return (uint32_t)atomic_get(&config_values[key]);
+}
+
+static int config_parse(int key, const char *value, uint32_t *out)
+{
+    const struct sensor_config_desc *desc = &config_desc[key];
+    char *end;
+
+    if (desc->value_names != NULL) {
+        for (uint32_t i = desc->min; i <= desc->max; i++) {
+            if (strcmp(value, desc->value_names[i]) == 0) {
+                *out = i;
+                return 0;
+            }
+        }
+
+        return -EINVAL;
+    }
+
+    unsigned long parsed = strtoul(value, &end, 10);
+    if (*value == '\0' || *end != '\0' || parsed < desc->min || parsed > desc->max) {
+        return -EINVAL;
+    }
+
+    *out = parsed;
+    return 0;
+}
+
+int sensor_config_set(const char *name, const char *value)
+{
+    char path[32];
+    uint32_t parsed;
+
+    int key = config_find(name, strlen(name));
+    if (key < 0) {
+        return key;
+    }
+
+    int rc = config_parse(key, value, &parsed);
+    if (rc < 0) {
+        return rc;
+    }
+
+    if (config_desc[key].apply != NULL) {
+        rc = config_desc[key].apply(parsed);
+        if (rc < 0) {
+            return rc;
+        }
+    }
+
+    atomic_set(&config_values[key], parsed);
+
+    if (!config_store_ready) {
+        LOG_WRN("Settings store unavailable, %s not persisted", config_desc[key].name);
+        return 0;
+    }
+
+    snprintf(path, sizeof(path), SENSOR_CONFIG_SUBTREE "/%s", config_desc[key].name);
+    rc = settings_save_one(path, &parsed, sizeof(parsed));
+    if (rc < 0) {
+        LOG_ERR("Cannot persist %s (%d)", config_desc[key].name, rc);
+    }
+
+    return rc;
+}
+
+const char *sensor_config_name(enum sensor_config_key key)
+{
+    return (key < SENSOR_CONFIG_COUNT) ? config_desc[key].name : "unknown";
+}
+
+int sensor_config_format(enum sensor_config_key key, char *buf, size_t len)
+{
+    uint32_t value = sensor_config_get(key);
+
+    if (config_desc[key].value_names != NULL) {
+        return snprintf(buf, len, "%s", config_desc[key].value_names[value]);
+    }
+
+    return snprintf(buf, len, "%u", value);
+}
+
+uint32_t sensor_config_load_time_us(void)
+{
+    return config_load_us;
+}
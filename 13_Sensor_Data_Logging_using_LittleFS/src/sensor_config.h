@@ -0,0 +1,26 @@
+#ifndef SENSOR_CONFIG_H
+#define SENSOR_CONFIG_H
+
+#include <zephyr/kernel.h>
+
+/* Runtime-tunable pipeline parameters, persisted under "sensor/<name>" in storage1_partition */
+enum sensor_config_key {
+    SENSOR_CONFIG_HUM_TEMP_MS,
+    SENSOR_CONFIG_PRESSURE_MS,
+    SENSOR_CONFIG_IMU_MS,
+    SENSOR_CONFIG_STORAGE_MS,
+    SENSOR_CONFIG_HTS221_PROFILE,
+    SENSOR_CONFIG_LPS22HB_PROFILE,
+    SENSOR_CONFIG_LPS22HB_MODE,
+    SENSOR_CONFIG_COUNT,
+};
+
+int sensor_config_init(void);
+int sensor_config_apply_all(void);
+uint32_t sensor_config_get(enum sensor_config_key key);
+int sensor_config_set(const char *name, const char *value);
+const char *sensor_config_name(enum sensor_config_key key);
+int sensor_config_format(enum sensor_config_key key, char *buf, size_t len);
+uint32_t sensor_config_load_time_us(void);
+
+#endif /* SENSOR_CONFIG_H */
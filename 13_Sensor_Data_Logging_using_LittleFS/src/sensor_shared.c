@@ -1,4 +1,30 @@
 #include "sensor_shared.h"
 
+#include <errno.h>
+#include <string.h>
+
 struct sensor_data_t sensor_data;
-struct k_mutex sensor_data_mutex;
+struct profiled_mutex sensor_data_mutex;
+
+const char *const sensor_profile_names[SENSOR_PROFILE_COUNT] = {
+    [SENSOR_PROFILE_LOW_POWER] = "low_power",
+    [SENSOR_PROFILE_BALANCED] = "balanced",
+    [SENSOR_PROFILE_LOW_NOISE] = "low_noise",
+};
+
+const char *sensor_profile_name(enum sensor_profile profile)
+{
+    return (profile < SENSOR_PROFILE_COUNT) ? sensor_profile_names[profile] : "unknown";
+}
+
+int sensor_profile_from_name(const char *name, enum sensor_profile *profile)
+{
+    for (int i = 0; i < SENSOR_PROFILE_COUNT; i++) {
+        if (strcmp(name, sensor_profile_names[i]) == 0) {
+            *profile = i;
+            return 0;
+        }
+    }
+
+    return -EINVAL;
+}
@@ -1,6 +1,8 @@
 #ifndef SENSOR_SHARED_H
 #define SENSOR_SHARED_H
 
+#include "profiled_mutex.h"
+
 #include <zephyr/kernel.h>
 
 struct sensor_data_t {
@@ -15,7 +17,20 @@ struct sensor_data_t {
     float gyro_z;
 };
 
+/* Noise/power trade-off applied through the sensors' own averaging and filtering */
+enum sensor_profile {
+    SENSOR_PROFILE_LOW_POWER,
+    SENSOR_PROFILE_BALANCED,
+    SENSOR_PROFILE_LOW_NOISE,
+    SENSOR_PROFILE_COUNT,
+};
+
+extern const char *const sensor_profile_names[SENSOR_PROFILE_COUNT];
+
+const char *sensor_profile_name(enum sensor_profile profile);
+int sensor_profile_from_name(const char *name, enum sensor_profile *profile);
+
 extern struct sensor_data_t sensor_data;
-extern struct k_mutex sensor_data_mutex;
+extern struct profiled_mutex sensor_data_mutex;
 
 #endif
@@ -0,0 +1,96 @@
+#include "sensor_worker.h"
+#include "sensor_config.h"
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+#include <errno.h>
+
+LOG_MODULE_REGISTER(sensor_worker);
+
+static void sensor_worker_thread(void *p1, void *p2, void *p3)
+{
+    struct sensor_worker *worker = p1;
+
+    for (;;) {
+        /* Parked: nothing runs until sensor_worker_start() gives the semaphore */
+        if (atomic_get(&worker->state) != SENSOR_WORKER_RUNNING) {
+            atomic_set(&worker->parked, 1);
+            LOG_INF("%s parked", worker->name);
+            k_sem_take(&worker->wake, K_FOREVER);
+            continue;
+        }
+
+        if (atomic_cas(&worker->parked, 1, 0)) {
+            LOG_INF("%s running", worker->name);
+        }
+
+        worker->work();
+        worker->iterations++;
+
+        int64_t last = k_uptime_get();
+
+        /* Sleep until the next period; a wakeup re-reads the state and the period, so stop
+         * and rate changes take effect immediately instead of after the old period.
+         */
+        while (atomic_get(&worker->state) == SENSOR_WORKER_RUNNING) {
+            int64_t remaining = last + sensor_config_get(worker->period_key) - k_uptime_get();
+
+            if (remaining <= 0) {
+                break;
+            }
+
+            k_sem_take(&worker->wake, K_MSEC(remaining));
+        }
+    }
+}
+
+void sensor_worker_init(struct sensor_worker *worker)
+{
+    k_sem_init(&worker->wake, 0, 1);
+
+    k_tid_t tid = k_thread_create(&worker->thread, worker->stack, worker->stack_size,
+                                  sensor_worker_thread, worker, NULL, NULL, worker->priority, 0,
+                                  K_NO_WAIT);
+    k_thread_name_set(tid, worker->name);
+}
+
+int sensor_worker_start(struct sensor_worker *worker)
+{
+    if (!atomic_cas(&worker->state, SENSOR_WORKER_STOPPED, SENSOR_WORKER_RUNNING)) {
+        return -EALREADY;
+    }
+
+    k_sem_give(&worker->wake);
+    return 0;
+}
+
+int sensor_worker_stop(struct sensor_worker *worker)
+{
+    if (!atomic_cas(&worker->state, SENSOR_WORKER_RUNNING, SENSOR_WORKER_STOPPED)) {
+        return -EALREADY;
+    }
+
+    /* The worker parks as soon as it sees the state; an iteration already in progress
+     * (e.g. an I2C transfer or a file write) completes first.
+     */
+    k_sem_give(&worker->wake);
+    return 0;
+}
+
+void sensor_worker_reschedule(struct sensor_worker *worker)
+{
+    if (atomic_get(&worker->state) == SENSOR_WORKER_RUNNING) {
+        k_sem_give(&worker->wake);
+    }
+}
+
+bool sensor_worker_is_running(const struct sensor_worker *worker)
+{
+    return atomic_get(&worker->state) == SENSOR_WORKER_RUNNING;
+}
+
+bool sensor_worker_is_parked(const struct sensor_worker *worker)
+{
+    return atomic_get(&worker->parked) != 0;
+}
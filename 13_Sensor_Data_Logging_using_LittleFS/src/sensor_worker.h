@@ -0,0 +1,53 @@
+#ifndef SENSOR_WORKER_H
+#define SENSOR_WORKER_H
+
+#include "sensor_config.h"
+
+#include <zephyr/kernel.h>
+
+enum sensor_worker_state {
+    SENSOR_WORKER_STOPPED,
+    SENSOR_WORKER_RUNNING,
+};
+
+/*
+ * Periodic acquisition/storage thread that is created once and parked while stopped.
+ * Start, stop and rate changes only flip an atomic state and give a semaphore, so they
+ * never wait for the worker's sleep or its current iteration to finish.
+ */
+struct sensor_worker {
+    const char *name;
+    void (*work)(void);
+    enum sensor_config_key period_key;
+    k_thread_stack_t *stack;
+    size_t stack_size;
+    int priority;
+
+    struct k_thread thread;
+    struct k_sem wake;
+    atomic_t state;
+    atomic_t parked;
+    uint32_t iterations;
+};
+
+#define SENSOR_WORKER_DEFINE(_name, _work, _period_key, _stack_size, _priority)                    \
+    K_THREAD_STACK_DEFINE(_name##_stack, _stack_size);                                             \
+    static struct sensor_worker _name = {                                                          \
+        .name = #_name,                                                                            \
+        .work = _work,                                                                             \
+        .period_key = _period_key,                                                                 \
+        .stack = _name##_stack,                                                                    \
+        .stack_size = K_THREAD_STACK_SIZEOF(_name##_stack),                                        \
+        .priority = _priority,                                                                     \
+        .state = ATOMIC_INIT(SENSOR_WORKER_STOPPED),                                               \
+        .parked = ATOMIC_INIT(1),                                                                  \
+    }
+
+void sensor_worker_init(struct sensor_worker *worker);
+int sensor_worker_start(struct sensor_worker *worker);
+int sensor_worker_stop(struct sensor_worker *worker);
+void sensor_worker_reschedule(struct sensor_worker *worker);
+bool sensor_worker_is_running(const struct sensor_worker *worker);
+bool sensor_worker_is_parked(const struct sensor_worker *worker);
+
+#endif /* SENSOR_WORKER_H */
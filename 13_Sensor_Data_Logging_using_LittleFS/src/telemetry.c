@@ -0,0 +1,244 @@
+#ifdef CONFIG_SENSOR_TELEMETRY
+
+#include "telemetry.h"
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/uart.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/crc.h>
+#include <zephyr/sys/ring_buffer.h>
+
+#include <string.h>
+
+LOG_MODULE_REGISTER(telemetry);
+
+#if DT_NODE_EXISTS(DT_ALIAS(telemetry_uart))
+static const struct device *const telemetry_dev = DEVICE_DT_GET(DT_ALIAS(telemetry_uart));
+#else
+#error ("Telemetry UART not found.");
+#endif
+
+#define TELEMETRY_HEADER_SIZE 8
+#define TELEMETRY_CRC_SIZE    2
+#define TELEMETRY_MAX_PAYLOAD 24
+#define TELEMETRY_MAX_PACKET  (TELEMETRY_HEADER_SIZE + TELEMETRY_MAX_PAYLOAD + TELEMETRY_CRC_SIZE)
+/* COBS adds one byte per started 254 bytes, plus the 0x00 delimiter */
+#define TELEMETRY_MAX_FRAME   (TELEMETRY_MAX_PACKET + 2)
+
+RING_BUF_DECLARE(telemetry_ring, CONFIG_SENSOR_TELEMETRY_BUF_SIZE);
+
+/* Serialises producers against each other and against the TX interrupt */
+static struct k_spinlock telemetry_lock;
+static bool telemetry_ready;
+static uint16_t telemetry_seq;
+static struct telemetry_stats telemetry_stats;
+
+static size_t cobs_encode(const uint8_t *src, size_t len, uint8_t *dst)
+{
+    size_t code_pos = 0;
+    size_t out = 1;
+    uint8_t code = 1;
+
+    for (size_t i = 0; i < len; i++) {
+        if (src[i] == 0) {
+            dst[code_pos] = code;
+            code_pos = out++;
+            code = 1;
+            continue;
+        }
+
+        dst[out++] = src[i];
+        if (++code == 0xff) {
+            dst[code_pos] = code;
+            code_pos = out++;
+            code = 1;
+        }
+    }
+
+    dst[code_pos] = code;
+    return out;
+}
+
+static void telemetry_uart_isr(const struct device *dev, void *user_data)
+{
+    uint8_t *data;
+    uint32_t len;
+    int sent;
+
+    if (!uart_irq_update(dev) || !uart_irq_tx_ready(dev)) {
+        return;
+    }
+
+    k_spinlock_key_t key = k_spin_lock(&telemetry_lock);
+
+    len = ring_buf_get_claim(&telemetry_ring, &data, CONFIG_SENSOR_TELEMETRY_BUF_SIZE);
+    if (len == 0) {
+        uart_irq_tx_disable(dev);
+    } else {
+        sent = uart_fifo_fill(dev, data, len);
+        sent = MAX(sent, 0);
+        ring_buf_get_finish(&telemetry_ring, sent);
+        telemetry_stats.sent += sent;
+    }
+
+    k_spin_unlock(&telemetry_lock, key);
+}
+
+/* Frames the payload and queues it whole; a packet is never split across a full buffer */
+static int telemetry_queue(enum telemetry_type type, const uint8_t *payload, size_t len, bool wait)
+{
+    uint8_t packet[TELEMETRY_MAX_PACKET];
+    uint8_t frame[TELEMETRY_MAX_FRAME];
+    size_t packet_len = TELEMETRY_HEADER_SIZE + len;
+    size_t frame_len;
+    k_spinlock_key_t key;
+
+    __ASSERT_NO_MSG(len <= TELEMETRY_MAX_PAYLOAD);
+
+    if (!telemetry_ready) {
+        return -ENODEV;
+    }
+
+    packet[0] = type;
+    packet[1] = TELEMETRY_VERSION;
+    memcpy(&packet[TELEMETRY_HEADER_SIZE], payload, len);
+
+    while (true) {
+        key = k_spin_lock(&telemetry_lock);
+
+        if (ring_buf_space_get(&telemetry_ring) >= TELEMETRY_MAX_FRAME) {
+            break;
+        }
+
+        if (!wait) {
+            telemetry_stats.dropped++;
+            k_spin_unlock(&telemetry_lock, key);
+            return -ENOMEM;
+        }
+
+        k_spin_unlock(&telemetry_lock, key);
+        k_sleep(K_TICKS(1));
+    }
+
+    /* Sequence and timestamp are taken under the lock so they follow the byte stream order */
+    sys_put_le16(telemetry_seq++, &packet[2]);
+    sys_put_le32((uint32_t)k_ticks_to_us_floor64(k_uptime_ticks()), &packet[4]);
+    sys_put_le16(crc16_itu_t(0xffff, packet, packet_len), &packet[packet_len]);
+
+    frame_len = cobs_encode(packet, packet_len + TELEMETRY_CRC_SIZE, frame);
+    frame[frame_len++] = 0x00;
+
+    ring_buf_put(&telemetry_ring, frame, frame_len);
+    telemetry_stats.packets++;
+    telemetry_stats.queued += frame_len;
+    telemetry_stats.high_water =
+        MAX(telemetry_stats.high_water, ring_buf_size_get(&telemetry_ring));
+
+    k_spin_unlock(&telemetry_lock, key);
+
+    uart_irq_tx_enable(telemetry_dev);
+    return 0;
+}
+
+int telemetry_send_hum_temp(const struct sensor_value *temp, const struct sensor_value *hum)
+{
+    uint8_t payload[4];
+
+    sys_put_le16((int16_t)(sensor_value_to_milli(temp) / 10), &payload[0]);
+    sys_put_le16((uint16_t)(sensor_value_to_milli(hum) / 10), &payload[2]);
+
+    return telemetry_queue(TELEMETRY_TYPE_HUM_TEMP, payload, sizeof(payload), false);
+}
+
+int telemetry_send_pressure(double kpa)
+{
+    uint8_t payload[4];
+
+    sys_put_le32((uint32_t)(kpa * 100000.0), payload);
+
+    return telemetry_queue(TELEMETRY_TYPE_PRESSURE, payload, sizeof(payload), false);
+}
+
+int telemetry_send_imu(const struct sensor_value accel[3], const struct sensor_value gyro[3])
+{
+    uint8_t payload[24];
+
+    for (int i = 0; i < 3; i++) {
+        sys_put_le32((int32_t)sensor_value_to_milli(&accel[i]), &payload[i * 4]);
+        sys_put_le32((int32_t)sensor_value_to_milli(&gyro[i]), &payload[12 + i * 4]);
+    }
+
+    return telemetry_queue(TELEMETRY_TYPE_IMU, payload, sizeof(payload), false);
+}
+
+/* IMU-sized packet with a counter in every field; waits for room instead of dropping */
+int telemetry_send_bench(uint32_t index)
+{
+    uint8_t payload[24];
+
+    for (int i = 0; i < 6; i++) {
+        sys_put_le32(index + i, &payload[i * 4]);
+    }
+
+    return telemetry_queue(TELEMETRY_TYPE_BENCH, payload, sizeof(payload), true);
+}
+
+int telemetry_flush(uint32_t timeout_ms)
+{
+    int64_t deadline = k_uptime_get() + timeout_ms;
+
+    while (!ring_buf_is_empty(&telemetry_ring)) {
+        if (k_uptime_get() >= deadline) {
+            return -EAGAIN;
+        }
+        k_sleep(K_TICKS(1));
+    }
+
+    return 0;
+}
+
+void telemetry_get_stats(struct telemetry_stats *stats)
+{
+    k_spinlock_key_t key = k_spin_lock(&telemetry_lock);
+
+    *stats = telemetry_stats;
+    k_spin_unlock(&telemetry_lock, key);
+}
+
+void telemetry_reset_stats(void)
+{
+    k_spinlock_key_t key = k_spin_lock(&telemetry_lock);
+    uint32_t baudrate = telemetry_stats.baudrate;
+
+    telemetry_stats = (struct telemetry_stats){.baudrate = baudrate};
+    k_spin_unlock(&telemetry_lock, key);
+}
+
+int telemetry_init(void)
+{
+    struct uart_config cfg;
+    int rc;
+
+    if (!device_is_ready(telemetry_dev)) {
+        LOG_ERR("telemetry: %s device not ready.", telemetry_dev->name);
+        return -ENODEV;
+    }
+
+    if (uart_config_get(telemetry_dev, &cfg) == 0) {
+        telemetry_stats.baudrate = cfg.baudrate;
+    }
+
+    rc = uart_irq_callback_user_data_set(telemetry_dev, telemetry_uart_isr, NULL);
+    if (rc < 0) {
+        LOG_ERR("Cannot set telemetry UART callback (%d)", rc);
+        return rc;
+    }
+
+    telemetry_ready = true;
+    LOG_INF("Telemetry on %s at %u baud", telemetry_dev->name, telemetry_stats.baudrate);
+    return 0;
+}
+
+#endif /* CONFIG_SENSOR_TELEMETRY */
@@ -0,0 +1,84 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <zephyr/drivers/sensor.h>
+#include <zephyr/kernel.h>
+
+/*
+ * Binary sensor telemetry on the UART aliased as telemetry-uart, separate from the console.
+ *
+ * Every packet is COBS encoded and terminated by a 0x00 byte, so a receiver can resynchronise
+ * on any zero. Decoded, a packet is (all fields little endian):
+ *
+ *   u8 type | u8 version | u16 sequence | u32 timestamp_us | payload | u16 crc
+ *
+ * The sequence is shared by all types, so the host detects lost packets from gaps. The CRC is
+ * CRC-16/CCITT-FALSE (crc16_itu_t with seed 0xffff) over everything before it. Payloads are
+ * fixed point:
+ *
+ *   HUM_TEMP  i16 temperature [0.01 C], u16 humidity [0.01 %RH]
+ *   PRESSURE  u32 pressure [0.01 Pa]
+ *   IMU       i32 accel x/y/z [mm/s^2], i32 gyro x/y/z [mrad/s]
+ *   BENCH     same layout as IMU, synthetic values from "sensor telemetry bench"
+ *
+ * Packets are queued whole into a ring buffer that the UART TX interrupt drains, so senders
+ * never wait for the line; a packet that does not fit is dropped and counted.
+ * tools/telemetry_decode.py is the matching host decoder.
+ */
+
+#define TELEMETRY_VERSION 1
+
+enum telemetry_type {
+    TELEMETRY_TYPE_HUM_TEMP = 1,
+    TELEMETRY_TYPE_PRESSURE = 2,
+    TELEMETRY_TYPE_IMU = 3,
+    TELEMETRY_TYPE_BENCH = 4,
+};
+
+struct telemetry_stats {
+    uint32_t baudrate;
+    uint32_t packets;    /* Packets queued */
+    uint32_t dropped;    /* Packets refused because the ring buffer was full */
+    uint32_t queued;     /* Encoded bytes queued */
+    uint32_t sent;       /* Bytes written to the UART FIFO */
+    uint32_t high_water; /* Largest ring buffer fill, in bytes */
+};
+
+#ifdef CONFIG_SENSOR_TELEMETRY
+
+int telemetry_init(void);
+int telemetry_send_hum_temp(const struct sensor_value *temp, const struct sensor_value *hum);
+int telemetry_send_pressure(double kpa);
+int telemetry_send_imu(const struct sensor_value accel[3], const struct sensor_value gyro[3]);
+int telemetry_send_bench(uint32_t index);
+int telemetry_flush(uint32_t timeout_ms);
+void telemetry_get_stats(struct telemetry_stats *stats);
+void telemetry_reset_stats(void);
+
+#else
+
+static inline int telemetry_init(void)
+{
+    return 0;
+}
+
+static inline int telemetry_send_hum_temp(const struct sensor_value *temp,
+                                          const struct sensor_value *hum)
+{
+    return 0;
+}
+
+static inline int telemetry_send_pressure(double kpa)
+{
+    return 0;
+}
+
+static inline int telemetry_send_imu(const struct sensor_value accel[3],
+                                     const struct sensor_value gyro[3])
+{
+    return 0;
+}
+
+#endif /* CONFIG_SENSOR_TELEMETRY */
+
+#endif /* TELEMETRY_H */
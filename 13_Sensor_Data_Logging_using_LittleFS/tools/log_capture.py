@@ -0,0 +1,92 @@
+#!/usr/bin/env python3
+"""Capture the log UART, count its bytes and decode dictionary-encoded logs.
+
+The firmware sends its logs on USART2 (Pmod connector) as binary dictionary messages: a
+format string address and the raw arguments. The strings stay on the host, in the
+log_dictionary.json of the same build, and Zephyr's log_parser.py turns the capture back into
+text. Bytes per message are printed for comparison with a text build
+(-DEXTRA_CONF_FILE=text.conf, captured without --decode).
+
+    log_capture.py /dev/ttyUSB1 --seconds 60 --out log.bin --decode build/zephyr/log_dictionary.json
+    log_capture.py --file log.bin --decode build/zephyr/log_dictionary.json
+"""
+
+import argparse
+import os
+import subprocess
+import sys
+import time
+
+
+def capture(port, baud, seconds, out):
+    try:
+        import serial
+    except ImportError:
+        sys.exit("pyserial is needed to read a port: pip install pyserial")
+
+    data = bytearray()
+    with serial.Serial(port, baud, timeout=0.1) as link:
+        link.reset_input_buffer()
+        end = time.monotonic() + seconds
+        try:
+            while time.monotonic() < end:
+                data += link.read(4096)
+        except KeyboardInterrupt:
+            pass
+    with open(out, "wb") as capture_file:
+        capture_file.write(data)
+    return bytes(data)
+
+
+def decode(database, path, zephyr_base):
+    parser = os.path.join(zephyr_base, "scripts", "logging", "dictionary", "log_parser.py")
+    if not os.path.exists(parser):
+        sys.exit(f"{parser} not found; set ZEPHYR_BASE or --zephyr-base")
+
+    result = subprocess.run(
+        [sys.executable, parser, database, path], capture_output=True, text=True
+    )
+    sys.stdout.write(result.stdout)
+    sys.stderr.write(result.stderr)
+    # Decoded messages start with the "[timestamp]" of the log output
+    return sum(1 for line in result.stdout.splitlines() if line.startswith("["))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("port", nargs="?", help="serial port of the log UART")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("--seconds", type=float, default=30.0)
+    parser.add_argument("--out", default="log.bin", help="where to store the capture")
+    parser.add_argument("--file", help="use an earlier capture instead of a port")
+    parser.add_argument("--decode", metavar="JSON", help="log_dictionary.json of the build")
+    parser.add_argument("--zephyr-base", default=os.environ.get("ZEPHYR_BASE", ""))
+    args = parser.parse_args()
+    if not args.port and not args.file:
+        parser.error("give a serial port or --file")
+
+    if args.file:
+        path = args.file
+        with open(path, "rb") as capture_file:
+            data = capture_file.read()
+        seconds = None
+    else:
+        path = args.out
+        data = capture(args.port, args.baud, args.seconds, path)
+        seconds = args.seconds
+
+    if args.decode:
+        messages = decode(args.decode, path, args.zephyr_base)
+    else:
+        messages = data.count(b"\n")
+
+    summary = f"# {len(data)} bytes, {messages} messages"
+    if messages:
+        summary += f", {len(data) / messages:.1f} bytes/message"
+    if seconds:
+        summary += f", {len(data) / seconds:.0f} B/s"
+    print(summary, file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
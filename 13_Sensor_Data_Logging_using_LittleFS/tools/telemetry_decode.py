@@ -0,0 +1,185 @@
+#!/usr/bin/env python3
+"""Decode the binary sensor telemetry stream (see src/telemetry.h).
+
+Reads from a serial port (needs pyserial) or from a raw capture file, prints one CSV
+line per packet and, with --stats, a throughput/loss summary every few seconds.
+
+    telemetry_decode.py /dev/ttyUSB0 --baud 921600
+    telemetry_decode.py --file capture.bin --quiet --stats 0
+"""
+
+import argparse
+import struct
+import sys
+import time
+
+VERSION = 1
+
+TYPE_HUM_TEMP = 1
+TYPE_PRESSURE = 2
+TYPE_IMU = 3
+TYPE_BENCH = 4
+
+HEADER = struct.Struct("<BBHI")
+PAYLOADS = {
+    TYPE_HUM_TEMP: (struct.Struct("<hH"), ("temperature_c", "humidity_pct"), (0.01, 0.01)),
+    TYPE_PRESSURE: (struct.Struct("<I"), ("pressure_pa",), (0.01,)),
+    TYPE_IMU: (
+        struct.Struct("<6i"),
+        ("accel_x", "accel_y", "accel_z", "gyro_x", "gyro_y", "gyro_z"),
+        (0.001,) * 6,
+    ),
+    TYPE_BENCH: (struct.Struct("<6I"), tuple(f"v{i}" for i in range(6)), (1,) * 6),
+}
+TYPE_NAMES = {
+    TYPE_HUM_TEMP: "hum_temp",
+    TYPE_PRESSURE: "pressure",
+    TYPE_IMU: "imu",
+    TYPE_BENCH: "bench",
+}
+
+
+def crc16_ccitt_false(data):
+    """CRC-16/CCITT-FALSE, the same as Zephyr's crc16_itu_t(0xffff, ...)."""
+    crc = 0xFFFF
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def cobs_decode(frame):
+    """Decode one COBS frame without its 0x00 delimiter; None if malformed."""
+    out = bytearray()
+    i = 0
+    while i < len(frame):
+        code = frame[i]
+        if code == 0 or i + code > len(frame):
+            return None
+        out += frame[i + 1 : i + code]
+        i += code
+        if code < 0xFF and i < len(frame):
+            out.append(0)
+    return bytes(out)
+
+
+class Decoder:
+    """Splits a byte stream into packets and keeps loss and error counters."""
+
+    def __init__(self):
+        self.buf = bytearray()
+        self.packets = 0
+        self.bytes = 0
+        self.bad_frames = 0
+        self.crc_errors = 0
+        self.lost = 0
+        self.last_seq = None
+
+    def feed(self, data):
+        self.bytes += len(data)
+        self.buf += data
+        packets = []
+        while True:
+            end = self.buf.find(0)
+            if end < 0:
+                break
+            frame = bytes(self.buf[:end])
+            del self.buf[: end + 1]
+            if frame:
+                packet = self._decode(frame)
+                if packet is not None:
+                    packets.append(packet)
+        return packets
+
+    def _decode(self, frame):
+        raw = cobs_decode(frame)
+        if raw is None or len(raw) < HEADER.size + 2:
+            self.bad_frames += 1
+            return None
+
+        body, crc = raw[:-2], struct.unpack("<H", raw[-2:])[0]
+        if crc16_ccitt_false(body) != crc:
+            self.crc_errors += 1
+            return None
+
+        ptype, version, seq, timestamp_us = HEADER.unpack_from(body)
+        layout = PAYLOADS.get(ptype)
+        if version != VERSION or layout is None or len(body) != HEADER.size + layout[0].size:
+            self.bad_frames += 1
+            return None
+
+        if self.last_seq is not None:
+            self.lost += (seq - self.last_seq - 1) & 0xFFFF
+        self.last_seq = seq
+        self.packets += 1
+
+        fmt, names, scales = layout
+        values = [v * s for v, s in zip(fmt.unpack_from(body, HEADER.size), scales)]
+        return TYPE_NAMES[ptype], seq, timestamp_us, dict(zip(names, values))
+
+
+def open_source(args):
+    if args.file:
+        return open(args.file, "rb")
+
+    try:
+        import serial
+    except ImportError:
+        sys.exit("pyserial is needed to read a port: pip install pyserial")
+    return serial.Serial(args.port, args.baud, timeout=0.1)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("port", nargs="?", help="serial port of telemetry-uart")
+    parser.add_argument("--baud", type=int, default=921600)
+    parser.add_argument("--file", help="decode a raw capture instead of a port")
+    parser.add_argument("--quiet", action="store_true", help="do not print packets")
+    parser.add_argument(
+        "--stats", type=float, default=5.0, help="summary interval in seconds, 0 for end only"
+    )
+    args = parser.parse_args()
+    if not args.port and not args.file:
+        parser.error("give a serial port or --file")
+
+    decoder = Decoder()
+    source = open_source(args)
+    start = last_report = time.monotonic()
+    last_packets = last_bytes = 0
+
+    def report(now):
+        nonlocal last_report, last_packets, last_bytes
+        span = max(now - last_report, 1e-6)
+        print(
+            f"# {decoder.packets} packets ({(decoder.packets - last_packets) / span:.0f}/s), "
+            f"{(decoder.bytes - last_bytes) / span:.0f} B/s, lost {decoder.lost}, "
+            f"crc errors {decoder.crc_errors}, bad frames {decoder.bad_frames}",
+            file=sys.stderr,
+        )
+        last_report, last_packets, last_bytes = now, decoder.packets, decoder.bytes
+
+    try:
+        while True:
+            data = source.read(4096)
+            if not data and args.file:
+                break
+            for name, seq, timestamp_us, values in decoder.feed(data):
+                if not args.quiet:
+                    fields = ",".join(f"{k}={v:g}" for k, v in values.items())
+                    print(f"{timestamp_us},{seq},{name},{fields}")
+            now = time.monotonic()
+            if args.stats and now - last_report >= args.stats:
+                report(now)
+    except KeyboardInterrupt:
+        pass
+    finally:
+        source.close()
+
+    last_report, last_packets, last_bytes = start, 0, 0
+    report(time.monotonic())
+
+
+if __name__ == "__main__":
+    main()
@@ -8,8 +8,8 @@
  *
  * @details
  * This file contains the implementation of the humidity sensor thread, which reads data from
- * the HTS221 sensor and sends the humidity data to the logger thread via a message queue
- * for logging.
+ * the HTS221 sensor and publishes the humidity data on humChan for the logger and other
+ * observers.
  *
  * @copyright Copyright (c) 2025
  */
@@ -19,18 +19,16 @@
 #include <zephyr/drivers/sensor.h>
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
+#include <zephyr/zbus/zbus.h>
 
 #include "sensor_structures.h"
 
 /** MACRO DEFINITIONS */
-#define HUM_SENSOR_THREAD_STACK_SIZE 512
+#define HUM_SENSOR_THREAD_STACK_SIZE 1024
 #define HUM_SENSOR_THREAD_PRIORITY   5
 #define HUM_SENSOR_THREAD_SLEEP_TIME K_SECONDS(30)
 
-#define HUM_Q_MAX_MSGS 10
-#define HUM_Q_ALIGN    32
-
-#define HUM_Q_TIMEOUT K_MSEC(1000)
+#define HUM_PUB_TIMEOUT K_MSEC(100)
 
 /** DEVICE CONFIGURATION */
 /* Check if the HTS221 sensor is defined in the device tree. */
@@ -49,8 +47,8 @@ int humSensorProcess(humidityData_t *humidityDataStruct);
 /* Register the logging module for humidity sensor operations. */
 LOG_MODULE_REGISTER(hum);
 
-/* Message queue to send humidity data to the logger thread */
-K_MSGQ_DEFINE(humMsgQ, sizeof(humidityData_t), HUM_Q_MAX_MSGS, HUM_Q_ALIGN);
+/* Channel for humidity samples, defined in sensor_channels.c */
+ZBUS_CHAN_DECLARE(humChan);
 
 /*
  * @brief humSensorProcess - Process humidity sensor data.
@@ -105,8 +103,8 @@ int humSensorProcess(humidityData_t *humidityDataStruct)
  * @date 26 August, 2025
  *
  * @details
- * This thread continuously reads humidity data from the HTS221 sensor and sends it to the logger
- * thread via a message queue for logging.
+ * This thread continuously reads humidity data from the HTS221 sensor and publishes it on
+ * humChan.
  *
  * @pre The sensor device must be initialized and ready.
  *
@@ -127,9 +125,9 @@ void humSensorThread(void *a, void *b, void *c)
 
 	while (1) {
 		if (humSensorProcess(&humidityDataStruct) == 0) {
-			/* Send the humidity data to the logger thread */
-			if (k_msgq_put(&humMsgQ, &humidityDataStruct, HUM_Q_TIMEOUT) != 0) {
-				LOG_WRN("Humidity message queue full, dropping data");
+			/* Publish once; zbus delivers to every observer */
+			if (zbus_chan_pub(&humChan, &humidityDataStruct, HUM_PUB_TIMEOUT) != 0) {
+				LOG_WRN("Humidity publish failed, dropping data");
 			}
 		}
 		k_sleep(HUM_SENSOR_THREAD_SLEEP_TIME);
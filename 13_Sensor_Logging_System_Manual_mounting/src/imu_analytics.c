@@ -0,0 +1,160 @@
+/*
+ * @file imu_analytics.c
+ * @author Dhruv Mamtora
+ * @version 0.1.0
+ * @date  18 October, 2026
+ *
+ * @brief Vibration statistics over full-rate IMU sample blocks.
+ *
+ * @details
+ * Consumer of the sample pool (sample_pool.c). For every 250 ms block it computes the RMS of
+ * the acceleration magnitude around its block mean (vibration level), the peak acceleration
+ * magnitude and the peak angular rate. "sensor vib" shows the latest block and the maxima
+ * since boot.
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+/** REQUIRED HEADER FILES */
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
+
+#include <math.h>
+
+#include "sensor_structures.h"
+
+/** MACRO DEFINITIONS */
+#define IMU_ANALYTICS_THREAD_STACK_SIZE 1024
+#define IMU_ANALYTICS_THREAD_PRIORITY   7
+
+#define IMU_ANALYTICS_Q_MAX_MSGS 4
+
+/* Function prototypes */
+void imuAnalyticsThread(void *a, void *b, void *c);
+void samplePoolRelease(sampleBlock_t *pBlock);
+void samplePoolDiscard(void *pItem);
+
+/** LOGGING CONFIGURATION */
+/* Register the logging module for IMU analytics. */
+LOG_MODULE_REGISTER(imu_analytics);
+
+/* Stream of sampleBlock_t pointers from the sample pool */
+STREAM_QUEUE_DEFINE(imuAnalyticsStream, sampleBlock_t *, IMU_ANALYTICS_Q_MAX_MSGS,
+		    STREAM_POLICY_DROP_NEWEST, K_NO_WAIT, samplePoolDiscard);
+
+typedef struct {
+	float fAccelRms;  /* m/s^2 */
+	float fAccelPeak; /* m/s^2 */
+	float fGyroPeak;  /* rad/s */
+} vibrationStats_t;
+
+/** GLOBAL VARIABLES */
+static vibrationStats_t latestStats;
+static vibrationStats_t maxStats;
+static uint32_t iBlocksAnalysed;
+static struct k_spinlock statsLock;
+
+/*
+ * @brief imuAnalyticsBlock - Compute the vibration statistics of one block.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @syntax
+ * static void imuAnalyticsBlock(const sampleBlock_t *pBlock, vibrationStats_t *pStats);
+ *
+ * @param[in] pBlock Block of full-rate samples.
+ * @param[out] pStats Statistics of the block.
+ *
+ * @return None.
+ */
+static void imuAnalyticsBlock(const sampleBlock_t *pBlock, vibrationStats_t *pStats)
+{
+	float fMagnitude[SAMPLE_BLOCK_SAMPLES];
+	float fMean = 0.0f;
+	float fSumSq = 0.0f;
+
+	pStats->fAccelPeak = 0.0f;
+	pStats->fGyroPeak = 0.0f;
+
+	for (int iNum = 0; iNum < pBlock->iCount; iNum++) {
+		const captureSample_t *pSample = &pBlock->samples[iNum];
+		const float *pA = pSample->fAccel;
+		const float *pG = pSample->fGyro;
+		float fGyro = sqrtf(pG[0] * pG[0] + pG[1] * pG[1] + pG[2] * pG[2]);
+
+		fMagnitude[iNum] = sqrtf(pA[0] * pA[0] + pA[1] * pA[1] + pA[2] * pA[2]);
+		fMean += fMagnitude[iNum];
+		pStats->fAccelPeak = MAX(pStats->fAccelPeak, fMagnitude[iNum]);
+		pStats->fGyroPeak = MAX(pStats->fGyroPeak, fGyro);
+	}
+
+	fMean /= pBlock->iCount;
+
+	for (int iNum = 0; iNum < pBlock->iCount; iNum++) {
+		float fDelta = fMagnitude[iNum] - fMean;
+
+		fSumSq += fDelta * fDelta;
+	}
+
+	pStats->fAccelRms = sqrtf(fSumSq / pBlock->iCount);
+}
+
+/*
+ * @brief imuAnalyticsThread - Analyse sample blocks as they arrive.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @syntax
+ * void imuAnalyticsThread(void *a, void *b, void *c);
+ *
+ * @param[in] a Unused parameter.
+ * @param[in] b Unused parameter.
+ * @param[in] c Unused parameter.
+ */
+void imuAnalyticsThread(void *a, void *b, void *c)
+{
+	sampleBlock_t *pBlock;
+	vibrationStats_t stats;
+
+	while (1) {
+		k_msgq_get(imuAnalyticsStream.pQueue, &pBlock, K_FOREVER);
+
+		imuAnalyticsBlock(pBlock, &stats);
+		samplePoolRelease(pBlock);
+
+		k_spinlock_key_t key = k_spin_lock(&statsLock);
+
+		latestStats = stats;
+		maxStats.fAccelRms = MAX(maxStats.fAccelRms, stats.fAccelRms);
+		maxStats.fAccelPeak = MAX(maxStats.fAccelPeak, stats.fAccelPeak);
+		maxStats.fGyroPeak = MAX(maxStats.fGyroPeak, stats.fGyroPeak);
+		iBlocksAnalysed++;
+		k_spin_unlock(&statsLock, key);
+	}
+}
+
+static int shellVibrationStats(const struct shell *sh, size_t argc, char **argv)
+{
+	k_spinlock_key_t key = k_spin_lock(&statsLock);
+	vibrationStats_t latest = latestStats;
+	vibrationStats_t max = maxStats;
+	uint32_t iBlocks = iBlocksAnalysed;
+
+	k_spin_unlock(&statsLock, key);
+
+	shell_print(sh, "blocks analysed: %u", iBlocks);
+	shell_print(sh, "latest: accel rms %.3f m/s^2, accel peak %.2f m/s^2, gyro peak %.3f rad/s",
+		    (double)latest.fAccelRms, (double)latest.fAccelPeak, (double)latest.fGyroPeak);
+	shell_print(sh, "max:    accel rms %.3f m/s^2, accel peak %.2f m/s^2, gyro peak %.3f rad/s",
+		    (double)max.fAccelRms, (double)max.fAccelPeak, (double)max.fGyroPeak);
+	return 0;
+}
+
+SHELL_SUBCMD_ADD((sensor), vib, NULL, "Show IMU vibration statistics", shellVibrationStats, 1, 0);
+
+/* Define the IMU analytics thread */
+K_THREAD_DEFINE(imuAnalyticsThreadId, IMU_ANALYTICS_THREAD_STACK_SIZE, imuAnalyticsThread, NULL,
+		NULL, NULL, IMU_ANALYTICS_THREAD_PRIORITY, 0, 0);
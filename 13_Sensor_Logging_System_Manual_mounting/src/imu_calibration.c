@@ -0,0 +1,557 @@
+/*
+ * @file imu_calibration.c
+ * @author Dhruv Mamtora
+ * @version 0.1.0
+ * @date  18 October, 2026
+ *
+ * @brief On-device calibration of the LSM6DSL accelerometer and gyroscope.
+ *
+ * @details
+ * Calibrated samples are produced in the IMU thread, so everything downstream (capture ring,
+ * decimator, logger) works on calibrated data. The engine has three parts:
+ *
+ *   - Gyro bias: every CALIB_WINDOW_SAMPLES the window statistics are checked; when the
+ *     device is stationary the window's mean gyro rate is blended into the bias estimate.
+ *   - Accel offset/scale: six-position calibration driven from the shell. "sensor calib accel
+ *     <pos>" records the mean of the next stationary window with the given axis pointing up
+ *     or down, "sensor calib solve" computes offset and scale per axis.
+ *   - Persistence: coefficients are stored with NVS in storage1_partition and loaded at boot.
+ *     Flash writes run on the system work queue, never in the IMU thread.
+ *
+ * The correction is folded into one scale and one offset per axis, so applying it costs one
+ * fused multiply-add per axis: out = raw * scale + (-offset * scale).
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+/** REQUIRED HEADER FILES */
+#include <zephyr/device.h>
+#include <zephyr/drivers/flash.h>
+#include <zephyr/drivers/sensor.h>
+#include <zephyr/fs/nvs.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/storage/flash_map.h>
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sensor_structures.h"
+
+/** MACRO DEFINITIONS */
+#define IMU_AXES 6
+
+/* One second of samples at the 104 Hz IMU rate */
+#define CALIB_WINDOW_SAMPLES 104
+
+/* Stationary thresholds: per-axis gyro variance in (rad/s)^2 and accel norm variance in
+ * (m/s^2)^2, i.e. roughly 0.6 dps and 0.05 m/s^2 of noise.
+ */
+#define CALIB_GYRO_VAR_MAX  1.0e-4f
+#define CALIB_ACCEL_VAR_MAX 2.5e-3f
+
+/* A steady rate above this is rotation, not bias */
+#define CALIB_GYRO_BIAS_MAX 0.1f
+
+/* Weight of a new stationary window in the gyro bias estimate */
+#define CALIB_BIAS_ALPHA 0.1f
+
+/* Save the gyro bias at most this often, and only when it moved */
+#define CALIB_BIAS_SAVE_INTERVAL_MS (60 * 60 * MSEC_PER_SEC)
+#define CALIB_BIAS_SAVE_DELTA       0.002f
+
+#define CALIB_CAPTURE_TIMEOUT K_SECONDS(10)
+
+#define CALIB_NVS_ID 1
+
+#define CALIB_STANDARD_G (SENSOR_G / 1000000.0f)
+
+/* Function prototypes */
+int imuCalibInit(void);
+void imuCalibProcess(const float *pRaw, motionData_t *motionDataStruct);
+
+/** LOGGING CONFIGURATION */
+/* Register the logging module for IMU calibration. */
+LOG_MODULE_REGISTER(imu_calib);
+
+/** GLOBAL VARIABLES */
+/* Coefficients shared with the shell; the IMU thread only takes the lock to copy them */
+static imuCalibData_t calibShared;
+static struct k_spinlock calibLock;
+static atomic_t calibDirty;
+
+/* Folded coefficients used in the hot path, owned by the IMU thread */
+static float fApplyScale[IMU_AXES];
+static float fApplyOffset[IMU_AXES];
+
+/* Window statistics, owned by the IMU thread. Values are accumulated relative to the first
+ * sample of the window to keep the float variance well conditioned.
+ */
+static float fWinRef[IMU_AXES + 1];
+static float fWinSum[IMU_AXES + 1];
+static float fWinSumSq[IMU_AXES + 1];
+static uint32_t iWinCount;
+static uint32_t iStationaryWindows;
+
+/* Six-position accel capture: one raw accel mean per position (+x, -x, +y, -y, +z, -z) */
+static const char *const cPositionNames[6] = {"+x", "-x", "+y", "-y", "+z", "-z"};
+static float fPositionMean[6][3];
+static atomic_t calibCapturedMask;
+static atomic_t calibCapturePos = ATOMIC_INIT(-1);
+K_SEM_DEFINE(calibCaptureSem, 0, 1);
+
+static struct nvs_fs calibFs;
+static bool bCalibFsReady;
+static float fSavedBias[3];
+static int64_t iLastBiasSaveMs;
+
+static void calibSaveHandler(struct k_work *work);
+K_WORK_DEFINE(calibSaveWork, calibSaveHandler);
+
+/*
+ * @brief calibSetDefaults - Reset coefficients to the identity correction.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @syntax
+ * static void calibSetDefaults(imuCalibData_t *pData);
+ *
+ * @param[out] pData Coefficients to reset.
+ *
+ * @return None.
+ */
+static void calibSetDefaults(imuCalibData_t *pData)
+{
+	memset(pData, 0, sizeof(*pData));
+	pData->iVersion = IMU_CALIB_VERSION;
+
+	for (int iAxis = 0; iAxis < 3; iAxis++) {
+		pData->fAccelScale[iAxis] = 1.0f;
+	}
+}
+
+/*
+ * @brief calibRefreshApply - Fold the shared coefficients into the hot-path arrays.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @details
+ * Called from the IMU thread only. Accel: out = (raw - offset) * scale. Gyro: out = raw - bias.
+ * Both are stored as out = raw * scale + offset so the apply loop is uniform.
+ *
+ * @syntax
+ * static void calibRefreshApply(void);
+ *
+ * @return None.
+ */
+static void calibRefreshApply(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&calibLock);
+
+	for (int iAxis = 0; iAxis < 3; iAxis++) {
+		fApplyScale[iAxis] = calibShared.fAccelScale[iAxis];
+		fApplyOffset[iAxis] = -calibShared.fAccelOffset[iAxis] * calibShared.fAccelScale[iAxis];
+		fApplyScale[iAxis + 3] = 1.0f;
+		fApplyOffset[iAxis + 3] = -calibShared.fGyroBias[iAxis];
+	}
+
+	k_spin_unlock(&calibLock, key);
+}
+
+/*
+ * @brief calibRequestSave - Queue a flash write of the current coefficients.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @syntax
+ * static void calibRequestSave(void);
+ *
+ * @return None.
+ */
+static void calibRequestSave(void)
+{
+	if (bCalibFsReady) {
+		k_work_submit(&calibSaveWork);
+	}
+}
+
+/*
+ * @brief calibSaveHandler - Write the coefficients to NVS.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @details
+ * Runs on the system work queue. NVS skips the write when the stored record is identical.
+ *
+ * @syntax
+ * static void calibSaveHandler(struct k_work *work);
+ *
+ * @param[in] work Unused.
+ *
+ * @return None.
+ */
+static void calibSaveHandler(struct k_work *work)
+{
+	imuCalibData_t snapshot;
+	k_spinlock_key_t key = k_spin_lock(&calibLock);
+
+	snapshot = calibShared;
+	k_spin_unlock(&calibLock, key);
+
+	ssize_t rc = nvs_write(&calibFs, CALIB_NVS_ID, &snapshot, sizeof(snapshot));
+
+	if (rc < 0) {
+		LOG_ERR("Calibration save failed: %d", (int)rc);
+		return;
+	}
+
+	LOG_INF("Calibration saved");
+}
+
+/*
+ * @brief imuCalibInit - Mount the calibration store and load the coefficients.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @details
+ * Mounts NVS over the whole of storage1_partition. A missing or stale record (different
+ * version) leaves the identity correction in place; a storage failure is logged but does
+ * not stop the IMU, which then runs with in-RAM calibration only.
+ *
+ * @syntax
+ * int imuCalibInit(void);
+ *
+ * @return 0 on success, -1 on failure.
+ *
+ * @retval 0 Success
+ * @retval -1 Error
+ */
+int imuCalibInit(void)
+{
+	struct flash_pages_info info;
+	imuCalibData_t stored;
+
+	calibSetDefaults(&calibShared);
+	calibRefreshApply();
+
+	calibFs.flash_device = FIXED_PARTITION_DEVICE(storage1_partition);
+	if (!device_is_ready(calibFs.flash_device)) {
+		LOG_ERR("Calibration flash device not ready");
+		return -1;
+	}
+
+	calibFs.offset = FIXED_PARTITION_OFFSET(storage1_partition);
+	if (flash_get_page_info_by_offs(calibFs.flash_device, calibFs.offset, &info) != 0) {
+		LOG_ERR("Unable to get calibration flash page info");
+		return -1;
+	}
+
+	calibFs.sector_size = info.size;
+	calibFs.sector_count = FIXED_PARTITION_SIZE(storage1_partition) / info.size;
+
+	int rc = nvs_mount(&calibFs);
+
+	if (rc != 0) {
+		LOG_ERR("Calibration NVS mount failed: %d", rc);
+		return -1;
+	}
+
+	bCalibFsReady = true;
+
+	if (nvs_read(&calibFs, CALIB_NVS_ID, &stored, sizeof(stored)) == sizeof(stored) &&
+	    stored.iVersion == IMU_CALIB_VERSION) {
+		calibShared = stored;
+		calibRefreshApply();
+		LOG_INF("Calibration loaded");
+	} else {
+		LOG_INF("No stored calibration, using defaults");
+	}
+
+	memcpy(fSavedBias, calibShared.fGyroBias, sizeof(fSavedBias));
+	iLastBiasSaveMs = k_uptime_get();
+
+	return 0;
+}
+
+/*
+ * @brief calibWindowDone - Evaluate a completed window and update the estimates.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @details
+ * Checks the stationary thresholds, then updates the gyro bias and completes a pending
+ * six-position capture. The bias is saved when it moved by more than CALIB_BIAS_SAVE_DELTA
+ * and the last save is at least CALIB_BIAS_SAVE_INTERVAL_MS old, to limit flash wear.
+ *
+ * @syntax
+ * static void calibWindowDone(void);
+ *
+ * @return None.
+ */
+static void calibWindowDone(void)
+{
+	float fMean[IMU_AXES + 1];
+	float fVar[IMU_AXES + 1];
+
+	for (int iNum = 0; iNum < IMU_AXES + 1; iNum++) {
+		float fDelta = fWinSum[iNum] / CALIB_WINDOW_SAMPLES;
+
+		fMean[iNum] = fWinRef[iNum] + fDelta;
+		fVar[iNum] = fWinSumSq[iNum] / CALIB_WINDOW_SAMPLES - fDelta * fDelta;
+	}
+
+	if (fVar[3] > CALIB_GYRO_VAR_MAX || fVar[4] > CALIB_GYRO_VAR_MAX ||
+	    fVar[5] > CALIB_GYRO_VAR_MAX || fVar[IMU_AXES] > CALIB_ACCEL_VAR_MAX) {
+		return;
+	}
+
+	iStationaryWindows++;
+
+	/* Complete a pending six-position capture with the raw accel mean */
+	atomic_val_t iPos = atomic_get(&calibCapturePos);
+
+	if (iPos >= 0) {
+		memcpy(fPositionMean[iPos], fMean, sizeof(fPositionMean[iPos]));
+		atomic_or(&calibCapturedMask, BIT(iPos));
+		atomic_set(&calibCapturePos, -1);
+		k_sem_give(&calibCaptureSem);
+	}
+
+	if (fabsf(fMean[3]) > CALIB_GYRO_BIAS_MAX || fabsf(fMean[4]) > CALIB_GYRO_BIAS_MAX ||
+	    fabsf(fMean[5]) > CALIB_GYRO_BIAS_MAX) {
+		return;
+	}
+
+	bool bSave = false;
+	k_spinlock_key_t key = k_spin_lock(&calibLock);
+
+	for (int iAxis = 0; iAxis < 3; iAxis++) {
+		float *pBias = &calibShared.fGyroBias[iAxis];
+
+		*pBias += CALIB_BIAS_ALPHA * (fMean[iAxis + 3] - *pBias);
+		if (fabsf(*pBias - fSavedBias[iAxis]) > CALIB_BIAS_SAVE_DELTA) {
+			bSave = true;
+		}
+	}
+
+	if (bSave && k_uptime_get() - iLastBiasSaveMs >= CALIB_BIAS_SAVE_INTERVAL_MS) {
+		memcpy(fSavedBias, calibShared.fGyroBias, sizeof(fSavedBias));
+		iLastBiasSaveMs = k_uptime_get();
+	} else {
+		bSave = false;
+	}
+
+	k_spin_unlock(&calibLock, key);
+
+	calibRefreshApply();
+
+	if (bSave) {
+		calibRequestSave();
+	}
+}
+
+/*
+ * @brief imuCalibProcess - Calibrate one raw IMU sample and update the online estimates.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @details
+ * Applies the folded correction with one fmaf() per axis, then accumulates the raw sample
+ * into the stationary-detection window. Coefficient changes made from the shell are picked
+ * up here, so the apply arrays are only ever written by the IMU thread.
+ *
+ * @pre imuCalibInit() must have been called.
+ *
+ * @syntax
+ * void imuCalibProcess(const float *pRaw, motionData_t *motionDataStruct);
+ *
+ * @param[in] pRaw Raw sample: accel x, y, z in m/s^2 then gyro x, y, z in rad/s.
+ * @param[out] motionDataStruct Calibrated sample.
+ *
+ * @return None.
+ */
+void imuCalibProcess(const float *pRaw, motionData_t *motionDataStruct)
+{
+	float fOut[IMU_AXES];
+
+	if (atomic_cas(&calibDirty, 1, 0)) {
+		calibRefreshApply();
+	}
+
+	for (int iAxis = 0; iAxis < IMU_AXES; iAxis++) {
+		fOut[iAxis] = fmaf(pRaw[iAxis], fApplyScale[iAxis], fApplyOffset[iAxis]);
+	}
+
+	motionDataStruct->accel.x = fOut[0];
+	motionDataStruct->accel.y = fOut[1];
+	motionDataStruct->accel.z = fOut[2];
+	motionDataStruct->gyro.x = fOut[3];
+	motionDataStruct->gyro.y = fOut[4];
+	motionDataStruct->gyro.z = fOut[5];
+
+	/* Window statistics on the raw data: six axes plus the accel norm */
+	float fSample[IMU_AXES + 1];
+
+	memcpy(fSample, pRaw, IMU_AXES * sizeof(float));
+	fSample[IMU_AXES] = sqrtf(pRaw[0] * pRaw[0] + pRaw[1] * pRaw[1] + pRaw[2] * pRaw[2]);
+
+	if (iWinCount == 0) {
+		memcpy(fWinRef, fSample, sizeof(fWinRef));
+		memset(fWinSum, 0, sizeof(fWinSum));
+		memset(fWinSumSq, 0, sizeof(fWinSumSq));
+	}
+
+	for (int iNum = 0; iNum < IMU_AXES + 1; iNum++) {
+		float fDelta = fSample[iNum] - fWinRef[iNum];
+
+		fWinSum[iNum] += fDelta;
+		fWinSumSq[iNum] = fmaf(fDelta, fDelta, fWinSumSq[iNum]);
+	}
+
+	if (++iWinCount == CALIB_WINDOW_SAMPLES) {
+		iWinCount = 0;
+		calibWindowDone();
+	}
+}
+
+static int shellCalibAccel(const struct shell *sh, size_t argc, char **argv)
+{
+	int iPos = -1;
+
+	for (int iNum = 0; iNum < (int)ARRAY_SIZE(cPositionNames); iNum++) {
+		if (strcmp(argv[1], cPositionNames[iNum]) == 0) {
+			iPos = iNum;
+			break;
+		}
+	}
+
+	if (iPos < 0) {
+		shell_error(sh, "position must be one of +x -x +y -y +z -z");
+		return -EINVAL;
+	}
+
+	k_sem_reset(&calibCaptureSem);
+	if (!atomic_cas(&calibCapturePos, -1, iPos)) {
+		shell_warn(sh, "capture already in progress");
+		return -EBUSY;
+	}
+
+	shell_print(sh, "hold still with %s pointing up...", cPositionNames[iPos]);
+
+	if (k_sem_take(&calibCaptureSem, CALIB_CAPTURE_TIMEOUT) != 0) {
+		atomic_set(&calibCapturePos, -1);
+		shell_error(sh, "no stationary window, capture cancelled");
+		return -ETIMEDOUT;
+	}
+
+	shell_print(sh, "%s: %.4f %.4f %.4f m/s^2", cPositionNames[iPos],
+		    (double)fPositionMean[iPos][0], (double)fPositionMean[iPos][1],
+		    (double)fPositionMean[iPos][2]);
+	return 0;
+}
+
+static int shellCalibSolve(const struct shell *sh, size_t argc, char **argv)
+{
+	float fOffset[3];
+	float fScale[3];
+
+	if (atomic_get(&calibCapturedMask) != BIT_MASK(6)) {
+		shell_error(sh, "capture all six positions first (mask 0x%02lx)",
+			    (unsigned long)atomic_get(&calibCapturedMask));
+		return -EINVAL;
+	}
+
+	for (int iAxis = 0; iAxis < 3; iAxis++) {
+		float fUp = fPositionMean[2 * iAxis][iAxis];
+		float fDown = fPositionMean[2 * iAxis + 1][iAxis];
+
+		if (fUp - fDown < CALIB_STANDARD_G) {
+			shell_error(sh, "axis %c: +/- readings not separated, recapture", 'x' + iAxis);
+			return -EINVAL;
+		}
+
+		fOffset[iAxis] = (fUp + fDown) / 2.0f;
+		fScale[iAxis] = 2.0f * CALIB_STANDARD_G / (fUp - fDown);
+	}
+
+	k_spinlock_key_t key = k_spin_lock(&calibLock);
+
+	memcpy(calibShared.fAccelOffset, fOffset, sizeof(fOffset));
+	memcpy(calibShared.fAccelScale, fScale, sizeof(fScale));
+	k_spin_unlock(&calibLock, key);
+
+	atomic_set(&calibDirty, 1);
+	atomic_clear(&calibCapturedMask);
+	calibRequestSave();
+
+	for (int iAxis = 0; iAxis < 3; iAxis++) {
+		shell_print(sh, "%c: offset %.4f m/s^2, scale %.5f", 'x' + iAxis,
+			    (double)fOffset[iAxis], (double)fScale[iAxis]);
+	}
+	return 0;
+}
+
+static int shellCalibSave(const struct shell *sh, size_t argc, char **argv)
+{
+	if (!bCalibFsReady) {
+		shell_error(sh, "calibration storage not available");
+		return -ENODEV;
+	}
+
+	calibRequestSave();
+	shell_print(sh, "save queued");
+	return 0;
+}
+
+static int shellCalibReset(const struct shell *sh, size_t argc, char **argv)
+{
+	k_spinlock_key_t key = k_spin_lock(&calibLock);
+
+	calibSetDefaults(&calibShared);
+	k_spin_unlock(&calibLock, key);
+
+	atomic_set(&calibDirty, 1);
+	atomic_clear(&calibCapturedMask);
+	calibRequestSave();
+	shell_print(sh, "calibration reset to defaults");
+	return 0;
+}
+
+static int shellCalibStatus(const struct shell *sh, size_t argc, char **argv)
+{
+	imuCalibData_t snapshot;
+	k_spinlock_key_t key = k_spin_lock(&calibLock);
+
+	snapshot = calibShared;
+	k_spin_unlock(&calibLock, key);
+
+	shell_print(sh, "storage: %s", bCalibFsReady ? "storage1_partition" : "unavailable");
+	shell_print(sh, "stationary windows: %u", iStationaryWindows);
+	shell_print(sh, "gyro bias: %.5f %.5f %.5f rad/s", (double)snapshot.fGyroBias[0],
+		    (double)snapshot.fGyroBias[1], (double)snapshot.fGyroBias[2]);
+	shell_print(sh, "accel offset: %.4f %.4f %.4f m/s^2", (double)snapshot.fAccelOffset[0],
+		    (double)snapshot.fAccelOffset[1], (double)snapshot.fAccelOffset[2]);
+	shell_print(sh, "accel scale: %.5f %.5f %.5f", (double)snapshot.fAccelScale[0],
+		    (double)snapshot.fAccelScale[1], (double)snapshot.fAccelScale[2]);
+	shell_print(sh, "captured positions: 0x%02lx", (unsigned long)atomic_get(&calibCapturedMask));
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(subCalib,
+			       SHELL_CMD_ARG(accel, NULL, "Capture a six-position point: <+x|-x|+y|-y|+z|-z>",
+					     shellCalibAccel, 2, 0),
+			       SHELL_CMD(solve, NULL, "Compute accel offset/scale and save", shellCalibSolve),
+			       SHELL_CMD(save, NULL, "Save coefficients to flash", shellCalibSave),
+			       SHELL_CMD(reset, NULL, "Reset to identity calibration", shellCalibReset),
+			       SHELL_CMD(status, NULL, "Show calibration coefficients", shellCalibStatus),
+			       SHELL_SUBCMD_SET_END);
+SHELL_SUBCMD_ADD((sensor), calib, &subCalib, "IMU calibration", NULL, 1, 0);
@@ -0,0 +1,397 @@
+/*
+ * @file imu_capture.c
+ * @author Dhruv Mamtora
+ * @version 0.1.0
+ * @date  18 October, 2026
+ *
+ * @brief Pre/post-trigger capture of full-rate IMU data.
+ *
+ * @details
+ * Works like an oscilloscope in normal trigger mode. Every full-rate sample from the IMU
+ * thread goes into a RAM ring sized for CAPTURE_PRE_TRIGGER_MS + CAPTURE_POST_TRIGGER_MS.
+ * A trigger (acceleration threshold, "sensor capture trigger" shell command or the sw0
+ * button) freezes the pre-trigger window, the ring keeps filling for the post-trigger
+ * window and the whole window is then written as one /lfs/capNNNN.bin file by the capture
+ * thread. Between captures only the decimated IMU stream reaches the logger thread.
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+/** REQUIRED HEADER FILES */
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/fs/fs.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/sys/atomic.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sensor_structures.h"
+
+/** MACRO DEFINITIONS */
+#define CAPTURE_THREAD_STACK_SIZE 2048
+#define CAPTURE_THREAD_PRIORITY   6
+
+#define CAPTURE_ODR_HZ          104
+#define CAPTURE_PRE_TRIGGER_MS  2000
+#define CAPTURE_POST_TRIGGER_MS 3000
+
+#define CAPTURE_PRE_SAMPLES  (CAPTURE_PRE_TRIGGER_MS * CAPTURE_ODR_HZ / 1000)
+#define CAPTURE_POST_SAMPLES (CAPTURE_POST_TRIGGER_MS * CAPTURE_ODR_HZ / 1000)
+#define CAPTURE_RING_SIZE    (CAPTURE_PRE_SAMPLES + CAPTURE_POST_SAMPLES)
+
+/* Trigger when |a| exceeds 1 g + deviation, compared squared (free fall is left to
+ * the LSM6DSL embedded engine in imu_events.c)
+ */
+#define CAPTURE_GRAVITY         9.80665f
+#define CAPTURE_ACCEL_DEVIATION 9.80665f
+#define CAPTURE_ACCEL_HIGH_SQ \
+	((CAPTURE_GRAVITY + CAPTURE_ACCEL_DEVIATION) * (CAPTURE_GRAVITY + CAPTURE_ACCEL_DEVIATION))
+
+#define CAPTURE_DIR         "/lfs"
+#define CAPTURE_FILE_PREFIX "cap"
+
+#define SW0_NODE DT_ALIAS(sw0)
+
+typedef enum {
+	CAPTURE_STATE_ARMED,
+	CAPTURE_STATE_POST_TRIGGER,
+	CAPTURE_STATE_FLUSH,
+} captureState_t;
+
+/* Function prototypes */
+void imuCaptureFeed(const motionData_t *motionDataStruct, uint32_t iTimestampMs);
+void imuCaptureTrigger(captureTrigger_t eSource);
+void imuCaptureThread(void *a, void *b, void *c);
+
+/** LOGGING CONFIGURATION */
+/* Register the logging module for IMU capture operations. */
+LOG_MODULE_REGISTER(imu_capture);
+
+/** GLOBAL VARIABLES */
+static captureSample_t captureRing[CAPTURE_RING_SIZE];
+static uint32_t iRingHead;   /* Next slot to write */
+static uint32_t iRingFilled; /* Valid samples in the ring, up to CAPTURE_RING_SIZE */
+
+/* Only the IMU thread moves ARMED -> POST_TRIGGER -> FLUSH, only the capture thread
+ * moves FLUSH -> ARMED, so the ring is never written and read at the same time.
+ */
+static atomic_t captureState = ATOMIC_INIT(CAPTURE_STATE_ARMED);
+static atomic_t captureRequest = ATOMIC_INIT(0);
+
+static captureFileHeader_t captureHeader;
+static uint32_t iPostRemaining;
+static uint32_t iCaptureCount;
+
+static K_SEM_DEFINE(captureFlushSem, 0, 1);
+
+#if DT_NODE_HAS_STATUS_OKAY(SW0_NODE)
+static const struct gpio_dt_spec captureButton = GPIO_DT_SPEC_GET(SW0_NODE, gpios);
+static struct gpio_callback captureButtonCbData;
+
+static void captureButtonPressed(const struct device *dev, struct gpio_callback *cb,
+				 uint32_t pins)
+{
+	imuCaptureTrigger(CAPTURE_TRIGGER_BUTTON);
+}
+
+/*
+ * @brief captureButtonInit - Configure sw0 as a capture trigger.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @syntax
+ * static void captureButtonInit(void);
+ *
+ * @return None.
+ */
+static void captureButtonInit(void)
+{
+	if (!gpio_is_ready_dt(&captureButton) ||
+	    gpio_pin_configure_dt(&captureButton, GPIO_INPUT) < 0 ||
+	    gpio_pin_interrupt_configure_dt(&captureButton, GPIO_INT_EDGE_TO_ACTIVE) < 0) {
+		LOG_WRN("sw0 capture trigger unavailable");
+		return;
+	}
+
+	gpio_init_callback(&captureButtonCbData, captureButtonPressed, BIT(captureButton.pin));
+	gpio_add_callback(captureButton.port, &captureButtonCbData);
+}
+#else
+static void captureButtonInit(void)
+{
+}
+#endif
+
+/*
+ * @brief imuCaptureTrigger - Request a capture.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @details
+ * Safe to call from ISR, shell or thread context. The request is served on the next IMU
+ * sample; requests while a capture is already in progress are ignored.
+ *
+ * @syntax
+ * void imuCaptureTrigger(captureTrigger_t eSource);
+ *
+ * @param[in] eSource What caused the trigger; stored in the capture file header.
+ *
+ * @return None.
+ */
+void imuCaptureTrigger(captureTrigger_t eSource)
+{
+	if (atomic_get(&captureState) == CAPTURE_STATE_ARMED) {
+		atomic_cas(&captureRequest, 0, eSource);
+	}
+}
+
+/*
+ * @brief imuCaptureFeed - Push one full-rate IMU sample into the capture ring.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @details
+ * Called by the IMU thread for every sample. Checks the threshold trigger, serves pending
+ * trigger requests and hands the frozen window to the capture thread once the
+ * post-trigger samples have been collected. Samples arriving while the window is being
+ * written are not kept.
+ *
+ * @syntax
+ * void imuCaptureFeed(const motionData_t *motionDataStruct, uint32_t iTimestampMs);
+ *
+ * @param[in] motionDataStruct Latest IMU sample.
+ * @param[in] iTimestampMs Uptime of the sample in milliseconds.
+ *
+ * @return None.
+ */
+void imuCaptureFeed(const motionData_t *motionDataStruct, uint32_t iTimestampMs)
+{
+	captureState_t eState = atomic_get(&captureState);
+
+	if (eState == CAPTURE_STATE_FLUSH) {
+		return;
+	}
+
+	captureSample_t *pSample = &captureRing[iRingHead];
+
+	pSample->iTimestampMs = iTimestampMs;
+	pSample->fAccel[0] = motionDataStruct->accel.x;
+	pSample->fAccel[1] = motionDataStruct->accel.y;
+	pSample->fAccel[2] = motionDataStruct->accel.z;
+	pSample->fGyro[0] = motionDataStruct->gyro.x;
+	pSample->fGyro[1] = motionDataStruct->gyro.y;
+	pSample->fGyro[2] = motionDataStruct->gyro.z;
+
+	iRingHead = (iRingHead + 1) % CAPTURE_RING_SIZE;
+	iRingFilled = MIN(iRingFilled + 1, CAPTURE_RING_SIZE);
+
+	if (eState == CAPTURE_STATE_ARMED) {
+		float fMagSq = pSample->fAccel[0] * pSample->fAccel[0] +
+			       pSample->fAccel[1] * pSample->fAccel[1] +
+			       pSample->fAccel[2] * pSample->fAccel[2];
+
+		if (fMagSq > CAPTURE_ACCEL_HIGH_SQ) {
+			imuCaptureTrigger(CAPTURE_TRIGGER_THRESHOLD);
+		}
+
+		atomic_val_t eSource = atomic_set(&captureRequest, 0);
+
+		if (eSource == 0) {
+			return;
+		}
+
+		/* The triggering sample is the first post-trigger sample */
+		captureHeader.iMagic = CAPTURE_FILE_MAGIC;
+		captureHeader.iTriggerTimestampMs = iTimestampMs;
+		captureHeader.iOdrHz = CAPTURE_ODR_HZ;
+		captureHeader.iPreTriggerCount = MIN(iRingFilled - 1, CAPTURE_PRE_SAMPLES);
+		captureHeader.iSampleCount = captureHeader.iPreTriggerCount + CAPTURE_POST_SAMPLES;
+		captureHeader.iTriggerSource = eSource;
+		iPostRemaining = CAPTURE_POST_SAMPLES - 1;
+		atomic_set(&captureState, CAPTURE_STATE_POST_TRIGGER);
+	} else if (iPostRemaining > 0) {
+		iPostRemaining--;
+	}
+
+	if (iPostRemaining == 0) {
+		atomic_set(&captureState, CAPTURE_STATE_FLUSH);
+		k_sem_give(&captureFlushSem);
+	}
+}
+
+/*
+ * @brief captureNextIndex - Find the next unused capture file number.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @syntax
+ * static uint32_t captureNextIndex(void);
+ *
+ * @return One more than the highest existing capNNNN.bin index, 0 if none exist.
+ */
+static uint32_t captureNextIndex(void)
+{
+	static struct fs_dirent entry;
+	struct fs_dir_t dir;
+	uint32_t iNext = 0;
+
+	fs_dir_t_init(&dir);
+	if (fs_opendir(&dir, CAPTURE_DIR) < 0) {
+		return 0;
+	}
+
+	while (fs_readdir(&dir, &entry) == 0 && entry.name[0] != '\0') {
+		if (strncmp(entry.name, CAPTURE_FILE_PREFIX, strlen(CAPTURE_FILE_PREFIX)) == 0) {
+			uint32_t iIndex = strtoul(entry.name + strlen(CAPTURE_FILE_PREFIX), NULL, 10);
+
+			iNext = MAX(iNext, iIndex + 1);
+		}
+	}
+
+	fs_closedir(&dir);
+	return iNext;
+}
+
+/*
+ * @brief captureWriteFile - Write the frozen capture window to a new file.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @details
+ * The window ends at the ring head and may wrap, so it is written with at most two
+ * fs_write() calls after the header.
+ *
+ * @syntax
+ * static int captureWriteFile(uint32_t iIndex);
+ *
+ * @param[in] iIndex File number used for the capNNNN.bin name.
+ *
+ * @return 0 on success, negative error code on failure.
+ */
+static int captureWriteFile(uint32_t iIndex)
+{
+	char cPath[32];
+	struct fs_file_t file;
+	uint32_t iCount = captureHeader.iSampleCount;
+	uint32_t iStart = (iRingHead + CAPTURE_RING_SIZE - iCount) % CAPTURE_RING_SIZE;
+	uint32_t iFirst = MIN(iCount, CAPTURE_RING_SIZE - iStart);
+	int rc;
+
+	snprintf(cPath, sizeof(cPath), CAPTURE_DIR "/" CAPTURE_FILE_PREFIX "%04u.bin", iIndex);
+
+	fs_file_t_init(&file);
+	rc = fs_open(&file, cPath, FS_O_CREATE | FS_O_WRITE);
+	if (rc < 0) {
+		LOG_ERR("Failed to open %s (%d)", cPath, rc);
+		return rc;
+	}
+
+	rc = fs_write(&file, &captureHeader, sizeof(captureHeader));
+	if (rc >= 0) {
+		rc = fs_write(&file, &captureRing[iStart], iFirst * sizeof(captureSample_t));
+	}
+	if (rc >= 0 && iFirst < iCount) {
+		rc = fs_write(&file, &captureRing[0], (iCount - iFirst) * sizeof(captureSample_t));
+	}
+
+	fs_close(&file);
+
+	if (rc < 0) {
+		LOG_ERR("Failed to write %s (%d)", cPath, rc);
+		return rc;
+	}
+
+	LOG_INF("Capture %s: %u samples (%u pre-trigger), source %u", cPath, iCount,
+		captureHeader.iPreTriggerCount, captureHeader.iTriggerSource);
+	return 0;
+}
+
+/*
+ * @brief imuCaptureThread - Persist completed captures.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @details
+ * Waits for a frozen capture window, writes it to flash and re-arms the trigger. The ring
+ * restarts empty so the next pre-trigger window only contains fresh samples.
+ *
+ * @syntax
+ * void imuCaptureThread(void *a, void *b, void *c);
+ *
+ * @param[in] a Unused parameter.
+ * @param[in] b Unused parameter.
+ * @param[in] c Unused parameter.
+ *
+ * @return None.
+ */
+void imuCaptureThread(void *a, void *b, void *c)
+{
+	uint32_t iIndex = 0;
+	bool bIndexKnown = false;
+
+	captureButtonInit();
+	LOG_INF("IMU capture thread started.");
+
+	while (1) {
+		k_sem_take(&captureFlushSem, K_FOREVER);
+
+		/* The filesystem is mounted by the logger thread, so look up the index lazily */
+		if (!bIndexKnown) {
+			iIndex = captureNextIndex();
+			bIndexKnown = true;
+		}
+
+		if (captureWriteFile(iIndex) == 0) {
+			iIndex++;
+			iCaptureCount++;
+		}
+
+		iRingFilled = 0;
+		atomic_set(&captureRequest, 0);
+		atomic_set(&captureState, CAPTURE_STATE_ARMED);
+	}
+}
+
+static int shellCaptureTrigger(const struct shell *sh, size_t argc, char **argv)
+{
+	if (atomic_get(&captureState) != CAPTURE_STATE_ARMED) {
+		shell_warn(sh, "capture already in progress");
+		return -EBUSY;
+	}
+
+	imuCaptureTrigger(CAPTURE_TRIGGER_SHELL);
+	shell_print(sh, "capture triggered");
+	return 0;
+}
+
+static int shellCaptureStatus(const struct shell *sh, size_t argc, char **argv)
+{
+	static const char *const cStateNames[] = {"armed", "post-trigger", "writing"};
+
+	shell_print(sh, "state: %s", cStateNames[atomic_get(&captureState)]);
+	shell_print(sh, "window: %u ms pre + %u ms post @ %u Hz (%u samples, %u bytes)",
+		    CAPTURE_PRE_TRIGGER_MS, CAPTURE_POST_TRIGGER_MS, CAPTURE_ODR_HZ,
+		    CAPTURE_RING_SIZE, (uint32_t)sizeof(captureRing));
+	shell_print(sh, "captures written: %u", iCaptureCount);
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(subCapture,
+			       SHELL_CMD(trigger, NULL, "Start a capture now", shellCaptureTrigger),
+			       SHELL_CMD(status, NULL, "Show capture state", shellCaptureStatus),
+			       SHELL_SUBCMD_SET_END);
+SHELL_SUBCMD_ADD((sensor), capture, &subCapture, "IMU pre/post-trigger capture", NULL, 1, 0);
+
+/* Define the capture writer thread */
+K_THREAD_DEFINE(imuCaptureThreadId, CAPTURE_THREAD_STACK_SIZE, imuCaptureThread, NULL, NULL, NULL,
+		CAPTURE_THREAD_PRIORITY, 0, 2000);
@@ -0,0 +1,317 @@
+/*
+ * @file imu_events.c
+ * @author Dhruv Mamtora
+ * @version 0.1.0
+ * @date  18 October, 2026
+ *
+ * @brief LSM6DSL embedded-function event detection (free-fall, tap, tilt).
+ *
+ * @details
+ * This file configures the free-fall, single/double-tap and tilt engines built into the
+ * LSM6DSL and routes them to its INT1 pin (irq-gpios). Detection runs entirely inside the
+ * sensor: the CPU and the I2C bus are idle until the pin fires. The interrupt only takes a
+ * timestamp and wakes the event thread, which reads the latched source registers once,
+ * turns every active source into a compact imuEvent_t record and hands it to the logger
+ * thread via a stream queue with the drop-newest policy.
+ *
+ * The Zephyr LSM6DSL driver must be built without trigger support
+ * (CONFIG_LSM6DSL_TRIGGER_NONE) so that this file owns the irq-gpios line.
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+/** REQUIRED HEADER FILES */
+#include <zephyr/device.h>
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/drivers/i2c.h>
+#include <zephyr/drivers/sensor.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+#include "sensor_structures.h"
+
+/** MACRO DEFINITIONS */
+#define IMU_EVENT_THREAD_STACK_SIZE 1024
+#define IMU_EVENT_THREAD_PRIORITY   4
+
+#define IMU_EVENT_Q_MAX_MSGS 32
+
+/* LSM6DSL register map (embedded functions subset) */
+#define LSM6DSL_REG_WAKE_UP_SRC 0x1B
+#define LSM6DSL_REG_TAP_SRC     0x1C
+#define LSM6DSL_REG_CTRL10_C    0x19
+#define LSM6DSL_REG_FUNC_SRC1   0x53
+#define LSM6DSL_REG_TAP_CFG     0x58
+#define LSM6DSL_REG_TAP_THS_6D  0x59
+#define LSM6DSL_REG_INT_DUR2    0x5A
+#define LSM6DSL_REG_WAKE_UP_THS 0x5B
+#define LSM6DSL_REG_WAKE_UP_DUR 0x5C
+#define LSM6DSL_REG_FREE_FALL   0x5D
+#define LSM6DSL_REG_MD1_CFG     0x5E
+
+/* Register bit fields */
+#define LSM6DSL_WAKE_UP_SRC_FF_IA      BIT(5)
+#define LSM6DSL_TAP_SRC_SINGLE_TAP     BIT(5)
+#define LSM6DSL_TAP_SRC_DOUBLE_TAP     BIT(4)
+#define LSM6DSL_FUNC_SRC1_TILT_IA      BIT(5)
+#define LSM6DSL_CTRL10_C_FUNC_EN       BIT(2)
+#define LSM6DSL_CTRL10_C_TILT_EN       BIT(3)
+#define LSM6DSL_TAP_CFG_INT_ENABLE     BIT(7)
+#define LSM6DSL_TAP_CFG_TAP_XYZ_EN     (BIT(3) | BIT(2) | BIT(1))
+#define LSM6DSL_TAP_CFG_LIR            BIT(0)
+#define LSM6DSL_WAKE_UP_THS_DOUBLE_TAP BIT(7)
+#define LSM6DSL_MD1_CFG_SINGLE_TAP     BIT(6)
+#define LSM6DSL_MD1_CFG_FF             BIT(4)
+#define LSM6DSL_MD1_CFG_DOUBLE_TAP     BIT(3)
+#define LSM6DSL_MD1_CFG_TILT           BIT(1)
+
+/*
+ * Detection thresholds for FS = +/-2 g at the 104 Hz ODR used by the IMU thread.
+ * TAP_THS: 12 x 62.5 mg = 750 mg.
+ * INT_DUR2: DUR = 3 (3 x 32 / ODR ~ 0.9 s double-tap window), QUIET = 2, SHOCK = 2.
+ * FREE_FALL: FF_DUR = 6 samples (~58 ms), FF_THS = 312 mg.
+ */
+#define IMU_EVENT_ODR_HZ       104
+#define IMU_EVENT_TAP_THS      0x0C
+#define IMU_EVENT_INT_DUR2     ((3 << 4) | (2 << 2) | 2)
+#define IMU_EVENT_FREE_FALL    ((6 << 3) | 0x03)
+#define IMU_EVENT_WAKE_UP_DUR  0x00
+
+/** DEVICE CONFIGURATION */
+#if DT_NODE_EXISTS(DT_ALIAS(imu_sensor))
+#define IMU_NODE DT_ALIAS(imu_sensor)
+#else
+#error ("IMU sensor not found.");
+#endif
+
+static const struct i2c_dt_spec imuBus = I2C_DT_SPEC_GET(IMU_NODE);
+static const struct gpio_dt_spec imuIrq = GPIO_DT_SPEC_GET(IMU_NODE, irq_gpios);
+static struct gpio_callback imuIrqCbData;
+
+/* Function prototypes */
+void imuEventThread(void *a, void *b, void *c);
+int imuEventsInit(void);
+int streamQueuePut(streamQueue_t *pStream, const void *pItem);
+
+/** LOGGING CONFIGURATION */
+/* Register the logging module for IMU event operations. */
+LOG_MODULE_REGISTER(imu_events);
+
+/* Event records for the logger thread; the first events of a burst are the ones to keep */
+STREAM_QUEUE_DEFINE(imuEventStream, imuEvent_t, IMU_EVENT_Q_MAX_MSGS, STREAM_POLICY_DROP_NEWEST,
+		    K_NO_WAIT, NULL);
+
+/* Signalled from the INT1 interrupt, taken by the event thread */
+static K_SEM_DEFINE(imuIrqSem, 0, 1);
+
+/* Uptime captured in the interrupt so the record reflects the event, not the I2C read */
+static volatile uint32_t iIrqTimestampMs;
+
+/*
+ * @brief imuIrqHandler - LSM6DSL INT1 interrupt callback.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @details
+ * Records the event timestamp and wakes the event thread. No bus access is done here.
+ *
+ * @syntax
+ * void imuIrqHandler(const struct device *dev, struct gpio_callback *cb, uint32_t pins);
+ *
+ * @param[in] dev Pointer to the GPIO port device.
+ * @param[in] cb Pointer to the callback structure.
+ * @param[in] pins Bitmask of the pins that triggered the interrupt.
+ *
+ * @return None.
+ */
+static void imuIrqHandler(const struct device *dev, struct gpio_callback *cb, uint32_t pins)
+{
+	iIrqTimestampMs = k_uptime_get_32();
+	k_sem_give(&imuIrqSem);
+}
+
+/*
+ * @brief imuEventPost - Queue one event record for the logger thread.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @syntax
+ * static void imuEventPost(uint32_t iTimestampMs, imuEventType_t eType, uint8_t iSource);
+ *
+ * @param[in] iTimestampMs Uptime of the interrupt in milliseconds.
+ * @param[in] eType Detected event type.
+ * @param[in] iSource Raw source register value for the event.
+ *
+ * @return None.
+ */
+static void imuEventPost(uint32_t iTimestampMs, imuEventType_t eType, uint8_t iSource)
+{
+	imuEvent_t event = {
+		.iTimestampMs = iTimestampMs,
+		.iEventType = eType,
+		.iSource = iSource,
+	};
+
+	/* Never block the event thread; an overflowing queue means the logger is stalled */
+	if (streamQueuePut(&imuEventStream, &event) != 0) {
+		LOG_WRN("IMU event queue full, dropping event %d", eType);
+	}
+}
+
+/*
+ * @brief imuEventsInit - Configure the LSM6DSL embedded functions and INT1 routing.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @details
+ * Sets the accelerometer ODR, programs the free-fall, tap and tilt engines with latched
+ * interrupts, routes them to INT1 and installs the irq-gpios callback.
+ *
+ * @pre The LSM6DSL device must be initialized and ready.
+ *
+ * @syntax
+ * int imuEventsInit(void);
+ *
+ * @return 0 on success, -1 on failure.
+ *
+ * @retval 0 Success
+ * @retval -1 Error
+ */
+int imuEventsInit(void)
+{
+	const struct device *const imuEventDev = DEVICE_DT_GET(IMU_NODE);
+	struct sensor_value odr_attr = {.val1 = IMU_EVENT_ODR_HZ, .val2 = 0};
+	int iReturn;
+
+	if (!device_is_ready(imuEventDev) || !i2c_is_ready_dt(&imuBus) ||
+	    !gpio_is_ready_dt(&imuIrq)) {
+		LOG_ERR("IMU event resources not ready.");
+		return -1;
+	}
+
+	/* The embedded engines run on the accelerometer data path */
+	if (sensor_attr_set(imuEventDev, SENSOR_CHAN_ACCEL_XYZ, SENSOR_ATTR_SAMPLING_FREQUENCY,
+			    &odr_attr) < 0) {
+		LOG_ERR("Cannot set sampling frequency for accelerometer.");
+		return -1;
+	}
+
+	const uint8_t config[][2] = {
+		{LSM6DSL_REG_TAP_CFG,
+		 LSM6DSL_TAP_CFG_INT_ENABLE | LSM6DSL_TAP_CFG_TAP_XYZ_EN | LSM6DSL_TAP_CFG_LIR},
+		{LSM6DSL_REG_TAP_THS_6D, IMU_EVENT_TAP_THS},
+		{LSM6DSL_REG_INT_DUR2, IMU_EVENT_INT_DUR2},
+		{LSM6DSL_REG_WAKE_UP_THS, LSM6DSL_WAKE_UP_THS_DOUBLE_TAP},
+		{LSM6DSL_REG_WAKE_UP_DUR, IMU_EVENT_WAKE_UP_DUR},
+		{LSM6DSL_REG_FREE_FALL, IMU_EVENT_FREE_FALL},
+		{LSM6DSL_REG_MD1_CFG, LSM6DSL_MD1_CFG_SINGLE_TAP | LSM6DSL_MD1_CFG_FF |
+					      LSM6DSL_MD1_CFG_DOUBLE_TAP | LSM6DSL_MD1_CFG_TILT},
+	};
+
+	for (size_t iNum = 0; iNum < ARRAY_SIZE(config); iNum++) {
+		iReturn = i2c_reg_write_byte_dt(&imuBus, config[iNum][0], config[iNum][1]);
+		if (iReturn < 0) {
+			LOG_ERR("Failed to write LSM6DSL reg 0x%02x (%d)", config[iNum][0], iReturn);
+			return -1;
+		}
+	}
+
+	/* CTRL10_C is shared with other embedded functions, so only touch our bits */
+	iReturn = i2c_reg_update_byte_dt(&imuBus, LSM6DSL_REG_CTRL10_C,
+					 LSM6DSL_CTRL10_C_FUNC_EN | LSM6DSL_CTRL10_C_TILT_EN,
+					 LSM6DSL_CTRL10_C_FUNC_EN | LSM6DSL_CTRL10_C_TILT_EN);
+	if (iReturn < 0) {
+		LOG_ERR("Failed to enable LSM6DSL embedded functions (%d)", iReturn);
+		return -1;
+	}
+
+	iReturn = gpio_pin_configure_dt(&imuIrq, GPIO_INPUT);
+	if (iReturn < 0) {
+		LOG_ERR("Failed to configure IMU irq pin (%d)", iReturn);
+		return -1;
+	}
+
+	gpio_init_callback(&imuIrqCbData, imuIrqHandler, BIT(imuIrq.pin));
+	gpio_add_callback(imuIrq.port, &imuIrqCbData);
+
+	iReturn = gpio_pin_interrupt_configure_dt(&imuIrq, GPIO_INT_EDGE_TO_ACTIVE);
+	if (iReturn < 0) {
+		LOG_ERR("Failed to configure IMU irq interrupt (%d)", iReturn);
+		return -1;
+	}
+
+	return 0;
+}
+
+/*
+ * @brief imuEventThread - Thread to decode LSM6DSL embedded-function interrupts.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @details
+ * Sleeps until INT1 fires, then reads the latched source registers (which also clears the
+ * latch) and posts one record per active source. The STM32 EXTI only supports edge
+ * interrupts, so the pin level is re-checked after the read to catch an event that was
+ * latched while INT1 was still high.
+ *
+ * @syntax
+ * void imuEventThread(void *a, void *b, void *c);
+ *
+ * @param[in] a Unused parameter.
+ * @param[in] b Unused parameter.
+ * @param[in] c Unused parameter.
+ *
+ * @return None.
+ */
+void imuEventThread(void *a, void *b, void *c)
+{
+	uint8_t iWakeTapSrc[2];
+	uint8_t iFuncSrc;
+
+	if (imuEventsInit() != 0) {
+		LOG_ERR("IMU event detection disabled.");
+		return;
+	}
+
+	LOG_INF("IMU event thread started.");
+
+	while (1) {
+		k_sem_take(&imuIrqSem, K_FOREVER);
+
+		do {
+			uint32_t iTimestampMs = iIrqTimestampMs;
+
+			/* WAKE_UP_SRC and TAP_SRC are adjacent: one burst covers both */
+			if (i2c_burst_read_dt(&imuBus, LSM6DSL_REG_WAKE_UP_SRC, iWakeTapSrc,
+					      sizeof(iWakeTapSrc)) < 0 ||
+			    i2c_reg_read_byte_dt(&imuBus, LSM6DSL_REG_FUNC_SRC1, &iFuncSrc) < 0) {
+				LOG_ERR("Failed to read LSM6DSL event sources");
+				break;
+			}
+
+			if (iWakeTapSrc[0] & LSM6DSL_WAKE_UP_SRC_FF_IA) {
+				imuEventPost(iTimestampMs, IMU_EVENT_FREE_FALL, iWakeTapSrc[0]);
+			}
+
+			if (iWakeTapSrc[1] & LSM6DSL_TAP_SRC_DOUBLE_TAP) {
+				imuEventPost(iTimestampMs, IMU_EVENT_DOUBLE_TAP, iWakeTapSrc[1]);
+			} else if (iWakeTapSrc[1] & LSM6DSL_TAP_SRC_SINGLE_TAP) {
+				imuEventPost(iTimestampMs, IMU_EVENT_SINGLE_TAP, iWakeTapSrc[1]);
+			}
+
+			if (iFuncSrc & LSM6DSL_FUNC_SRC1_TILT_IA) {
+				imuEventPost(iTimestampMs, IMU_EVENT_TILT, iFuncSrc);
+			}
+
+			iIrqTimestampMs = k_uptime_get_32();
+		} while (gpio_pin_get_dt(&imuIrq) > 0);
+	}
+}
+
+/* Define the IMU event thread */
+K_THREAD_DEFINE(imuEventThreadId, IMU_EVENT_THREAD_STACK_SIZE, imuEventThread, NULL, NULL, NULL,
+		IMU_EVENT_THREAD_PRIORITY, 0, 2000);
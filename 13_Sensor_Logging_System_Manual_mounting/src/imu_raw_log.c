@@ -0,0 +1,135 @@
+/*
+ * @file imu_raw_log.c
+ * @author Dhruv Mamtora
+ * @version 0.1.0
+ * @date  18 October, 2026
+ *
+ * @brief Optional full-rate IMU recording to flash.
+ *
+ * @details
+ * Consumer of the sample pool (sample_pool.c). While enabled with "sensor raw on", every block
+ * of full-rate samples is appended to /lfs/raw.bin as captureSample_t records, written
+ * straight from the shared block. At 104 Hz this is about 2.9 kB/s, so recording is off by
+ * default and blocks are released unread while it is off.
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+/** REQUIRED HEADER FILES */
+#include <zephyr/fs/fs.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/sys/atomic.h>
+
+#include <string.h>
+
+#include "sensor_structures.h"
+
+/** MACRO DEFINITIONS */
+#define IMU_RAW_LOG_THREAD_STACK_SIZE 2048
+#define IMU_RAW_LOG_THREAD_PRIORITY   7
+
+/* Room for a flash page erase without dropping blocks */
+#define IMU_RAW_LOG_Q_MAX_MSGS 6
+
+#define IMU_RAW_LOG_FILE "/lfs/raw.bin"
+
+/* Function prototypes */
+void imuRawLogThread(void *a, void *b, void *c);
+void samplePoolRelease(sampleBlock_t *pBlock);
+void samplePoolDiscard(void *pItem);
+
+/** LOGGING CONFIGURATION */
+/* Register the logging module for raw IMU logging. */
+LOG_MODULE_REGISTER(imu_raw_log);
+
+/* Stream of sampleBlock_t pointers from the sample pool */
+STREAM_QUEUE_DEFINE(imuRawLogStream, sampleBlock_t *, IMU_RAW_LOG_Q_MAX_MSGS,
+		    STREAM_POLICY_DROP_NEWEST, K_NO_WAIT, samplePoolDiscard);
+
+/** GLOBAL VARIABLES */
+static atomic_t bRawLogEnabled;
+static uint32_t iRawBlocksWritten;
+
+/*
+ * @brief imuRawLogThread - Append shared sample blocks to raw.bin while enabled.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @details
+ * The file stays open while recording and is closed by the first block that arrives after
+ * recording was switched off.
+ *
+ * @syntax
+ * void imuRawLogThread(void *a, void *b, void *c);
+ *
+ * @param[in] a Unused parameter.
+ * @param[in] b Unused parameter.
+ * @param[in] c Unused parameter.
+ */
+void imuRawLogThread(void *a, void *b, void *c)
+{
+	struct fs_file_t file;
+	sampleBlock_t *pBlock;
+	bool bOpen = false;
+
+	fs_file_t_init(&file);
+
+	while (1) {
+		k_msgq_get(imuRawLogStream.pQueue, &pBlock, K_FOREVER);
+
+		if (atomic_get(&bRawLogEnabled)) {
+			if (!bOpen) {
+				int rc = fs_open(&file, IMU_RAW_LOG_FILE,
+						 FS_O_CREATE | FS_O_WRITE | FS_O_APPEND);
+
+				if (rc < 0) {
+					LOG_ERR("Failed to open raw.bin (%d)", rc);
+					atomic_clear(&bRawLogEnabled);
+				} else {
+					bOpen = true;
+				}
+			}
+
+			if (bOpen) {
+				/* Written straight from the shared block, no staging copy */
+				if (fs_write(&file, pBlock->samples,
+					     pBlock->iCount * sizeof(captureSample_t)) < 0) {
+					LOG_ERR("Failed to write to raw.bin");
+				} else {
+					iRawBlocksWritten++;
+				}
+			}
+		} else if (bOpen) {
+			fs_close(&file);
+			bOpen = false;
+		}
+
+		samplePoolRelease(pBlock);
+	}
+}
+
+static int shellRawLog(const struct shell *sh, size_t argc, char **argv)
+{
+	if (argc == 2 && strcmp(argv[1], "on") == 0) {
+		atomic_set(&bRawLogEnabled, 1);
+	} else if (argc == 2 && strcmp(argv[1], "off") == 0) {
+		atomic_clear(&bRawLogEnabled);
+	} else if (argc != 1) {
+		shell_error(sh, "usage: sensor raw [on|off]");
+		return -EINVAL;
+	}
+
+	shell_print(sh, "raw recording %s, %u blocks written",
+		    atomic_get(&bRawLogEnabled) ? "on" : "off", iRawBlocksWritten);
+	return 0;
+}
+
+SHELL_SUBCMD_ADD((sensor), raw, NULL, "Full-rate IMU recording to raw.bin: raw [on|off]",
+		 shellRawLog, 1, 1);
+
+/* Define the raw IMU log thread */
+K_THREAD_DEFINE(imuRawLogThreadId, IMU_RAW_LOG_THREAD_STACK_SIZE, imuRawLogThread, NULL, NULL,
+		NULL, IMU_RAW_LOG_THREAD_PRIORITY, 0, 0);
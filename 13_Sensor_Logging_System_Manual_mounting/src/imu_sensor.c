@@ -8,7 +8,7 @@
  *
  * @details
  * This file implements functions to initialize the LSM6DSL IMU sensor, read accelerometer
- * and gyroscope data, and send the data to a logger thread via a message queue.
+ * and gyroscope data, and publish the decimated data on imuChan.
  *
  * @copyright Copyright (c) 2025
  */
@@ -18,18 +18,19 @@
 #include <zephyr/drivers/sensor.h>
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
+#include <zephyr/zbus/zbus.h>
 
 #include "sensor_structures.h"
 
 /** MACRO DEFINITIONS */
 #define IMU_SENSOR_THREAD_STACK_SIZE 1024
 #define IMU_SENSOR_THREAD_PRIORITY   5
-#define IMU_SENSOR_THREAD_SLEEP_TIME K_SECONDS(30)
 
-#define IMU_Q_MAX_MSGS 10
-#define IMU_Q_ALIGN    32
+/* Full-rate acquisition feeds the capture ring and the decimator (imu_decimator.c) */
+#define IMU_SENSOR_ODR_HZ 104
+#define IMU_SENSOR_PERIOD K_USEC(USEC_PER_SEC / IMU_SENSOR_ODR_HZ)
 
-#define IMU_Q_TIMEOUT K_MSEC(1000)
+#define IMU_PUB_TIMEOUT K_MSEC(100)
 
 /** DEVICE CONFIGURATION */
 /* Check if the LSM6DSL sensor is defined in the device tree. */
@@ -43,52 +44,54 @@ const struct device *const imuDev = DEVICE_DT_GET(DT_ALIAS(imu_sensor));
 /* Function prototypes */
 void imuSensorThread(void *a, void *b, void *c);
 int imuSensorProcess(motionData_t *motionDataStruct);
+int imuSensorInit(void);
+int imuCalibInit(void);
+void imuCalibProcess(const float *pRaw, motionData_t *motionDataStruct);
+void imuCaptureFeed(const motionData_t *motionDataStruct, uint32_t iTimestampMs);
+void samplePoolFeed(const motionData_t *motionDataStruct, uint32_t iTimestampMs);
+int imuDecimatorInit(void);
+bool imuDecimatorPush(const motionData_t *inStruct, motionData_t *outStruct);
+void latencyRecord(latencyStage_t eStage, uint32_t iStartCycles);
 
 /** LOGGING CONFIGURATION */
 /* Register the logging module for IMU sensor operations. */
 LOG_MODULE_REGISTER(imu);
 
-/* Message queue to send IMU data to the logger thread */
-K_MSGQ_DEFINE(imuMsgQ, sizeof(motionData_t), IMU_Q_MAX_MSGS, IMU_Q_ALIGN);
+/* Channel for decimated IMU samples, defined in sensor_channels.c */
+ZBUS_CHAN_DECLARE(imuChan);
+
+/* Paces full-rate acquisition */
+K_TIMER_DEFINE(imuSampleTimer, NULL, NULL);
 
 /*
- * @brief imuSensorProcess - Process IMU sensor data.
+ * @brief imuSensorInit - Configure the LSM6DSL output data rate.
  *
  * @author Dhruv Mamtora
- * @date 27 August, 2025
+ * @date 18 October, 2026
  *
  * @details
- * This function reads data from the LSM6DSL IMU sensor and updates the provided motionDataStruct
- * with the latest accelerometer and gyroscope values.
+ * Sets the accelerometer and gyroscope ODR to IMU_SENSOR_ODR_HZ once, before the thread
+ * starts sampling at the same rate.
  *
  * @pre The IMU sensor device must be initialized and ready.
  *
  * @syntax
- * int imuSensorProcess(motionData_t *motionDataStruct);
- *
- * @param[in] motionDataStruct Pointer to the structure to store the latest motion data.
- * @param[out] motionDataStruct->accel Updated with the latest accelerometer data.
- * @param[out] motionDataStruct->gyro Updated with the latest gyroscope data.
+ * int imuSensorInit(void);
  *
  * @return 0 on success, -1 on failure.
  *
  * @retval 0 Success
  * @retval -1 Error
  */
-int imuSensorProcess(motionData_t *motionDataStruct)
+int imuSensorInit(void)
 {
+	struct sensor_value odr_attr = {.val1 = IMU_SENSOR_ODR_HZ, .val2 = 0};
 
 	if (!device_is_ready(imuDev)) {
 		LOG_ERR("sensor: %s device not ready.", imuDev->name);
 		return -1;
 	}
 
-	struct sensor_value odr_attr;
-
-	/* set accel/gyro sampling frequency to 104 Hz */
-	odr_attr.val1 = 104;
-	odr_attr.val2 = 0;
-
 	if (sensor_attr_set(imuDev, SENSOR_CHAN_ACCEL_XYZ, SENSOR_ATTR_SAMPLING_FREQUENCY,
 			    &odr_attr) < 0) {
 		LOG_ERR("Cannot set sampling frequency for accelerometer.");
@@ -101,39 +104,62 @@ int imuSensorProcess(motionData_t *motionDataStruct)
 		return -1;
 	}
 
+	return 0;
+}
+
+/*
+ * @brief imuSensorProcess - Process IMU sensor data.
+ *
+ * @author Dhruv Mamtora
+ * @date 27 August, 2025
+ *
+ * @details
+ * This function reads data from the LSM6DSL IMU sensor and updates the provided motionDataStruct
+ * with the latest calibrated accelerometer and gyroscope values (see imu_calibration.c).
+ *
+ * @pre imuSensorInit() must have succeeded.
+ *
+ * @syntax
+ * int imuSensorProcess(motionData_t *motionDataStruct);
+ *
+ * @param[in] motionDataStruct Pointer to the structure to store the latest motion data.
+ * @param[out] motionDataStruct->accel Updated with the latest accelerometer data.
+ * @param[out] motionDataStruct->gyro Updated with the latest gyroscope data.
+ *
+ * @return 0 on success, -1 on failure.
+ *
+ * @retval 0 Success
+ * @retval -1 Error
+ */
+int imuSensorProcess(motionData_t *motionDataStruct)
+{
+	uint32_t iStartCycles = k_cycle_get_32();
+
+	/* One fetch reads both accelerometer and gyroscope output registers */
 	if (sensor_sample_fetch(imuDev) < 0) {
 		LOG_ERR("Sensor sample update error");
 		return -1;
 	}
 
-	struct sensor_value accel_x, accel_y, accel_z;
-	struct sensor_value gyro_x, gyro_y, gyro_z;
+	latencyRecord(LATENCY_STAGE_FETCH, iStartCycles);
+	iStartCycles = k_cycle_get_32();
 
-	/* Fetch accelerometer data */
-	if (sensor_sample_fetch_chan(imuDev, SENSOR_CHAN_ACCEL_XYZ) < 0) {
-		LOG_ERR("Accelerometer Sensor sample update error");
-		return -1;
-	}
-	sensor_channel_get(imuDev, SENSOR_CHAN_ACCEL_X, &accel_x);
-	sensor_channel_get(imuDev, SENSOR_CHAN_ACCEL_Y, &accel_y);
-	sensor_channel_get(imuDev, SENSOR_CHAN_ACCEL_Z, &accel_z);
+	struct sensor_value accel[3];
+	struct sensor_value gyro[3];
+	float fRaw[6];
 
-	motionDataStruct->accel.x = sensor_value_to_double(&accel_x);
-	motionDataStruct->accel.y = sensor_value_to_double(&accel_y);
-	motionDataStruct->accel.z = sensor_value_to_double(&accel_z);
+	sensor_channel_get(imuDev, SENSOR_CHAN_ACCEL_XYZ, accel);
+	sensor_channel_get(imuDev, SENSOR_CHAN_GYRO_XYZ, gyro);
 
-	/* Fetch gyroscope data */
-	if (sensor_sample_fetch_chan(imuDev, SENSOR_CHAN_GYRO_XYZ) < 0) {
-		LOG_ERR("Gyroscope Sensor sample update error");
-		return -1;
+	for (int iAxis = 0; iAxis < 3; iAxis++) {
+		fRaw[iAxis] = sensor_value_to_float(&accel[iAxis]);
+		fRaw[iAxis + 3] = sensor_value_to_float(&gyro[iAxis]);
 	}
-	sensor_channel_get(imuDev, SENSOR_CHAN_GYRO_X, &gyro_x);
-	sensor_channel_get(imuDev, SENSOR_CHAN_GYRO_Y, &gyro_y);
-	sensor_channel_get(imuDev, SENSOR_CHAN_GYRO_Z, &gyro_z);
 
-	motionDataStruct->gyro.x = sensor_value_to_double(&gyro_x);
-	motionDataStruct->gyro.y = sensor_value_to_double(&gyro_y);
-	motionDataStruct->gyro.z = sensor_value_to_double(&gyro_z);
+	/* Apply the calibration and feed the online bias estimator */
+	imuCalibProcess(fRaw, motionDataStruct);
+
+	latencyRecord(LATENCY_STAGE_CONVERT, iStartCycles);
 
 	return 0;
 }
@@ -145,8 +171,9 @@ int imuSensorProcess(motionData_t *motionDataStruct)
  * @date 27 August, 2025
  *
  * @details
- * This thread function continuously reads data from the LSM6DSL IMU sensor at defined intervals
- * and sends the data to the logger thread via a message queue.
+ * This thread function reads the LSM6DSL IMU sensor at IMU_SENSOR_ODR_HZ. Every sample is fed to
+ * the capture ring, the shared sample pool and the anti-aliasing decimator; each decimated
+ * sample is published on imuChan.
  *
  * @syntax
  * void imuSensorThread(void *a, void *b, void *c);
@@ -158,17 +185,44 @@ int imuSensorProcess(motionData_t *motionDataStruct)
 void imuSensorThread(void *a, void *b, void *c)
 {
 	motionData_t motionDataStruct;
+	motionData_t decimatedStruct;
+
+	if (imuSensorInit() != 0 || imuDecimatorInit() != 0) {
+		return;
+	}
+
+	/* Without the calibration store the IMU still runs, calibrated from RAM only */
+	imuCalibInit();
 
 	LOG_INF("IMU sensor thread started.");
 
+	k_timer_start(&imuSampleTimer, IMU_SENSOR_PERIOD, IMU_SENSOR_PERIOD);
+
 	while (1) {
-		if (imuSensorProcess(&motionDataStruct) == 0) {
-			/* Send the motion data to the logger thread via message queue */
-			if (k_msgq_put(&imuMsgQ, &motionDataStruct, IMU_Q_TIMEOUT) != 0) {
-				LOG_WRN("IMU message queue full, dropping data");
-			}
+		k_timer_status_sync(&imuSampleTimer);
+
+		if (imuSensorProcess(&motionDataStruct) != 0) {
+			continue;
+		}
+
+		uint32_t iTimestampMs = k_uptime_get_32();
+
+		imuCaptureFeed(&motionDataStruct, iTimestampMs);
+		samplePoolFeed(&motionDataStruct, iTimestampMs);
+
+		if (!imuDecimatorPush(&motionDataStruct, &decimatedStruct)) {
+			continue;
 		}
-		k_sleep(IMU_SENSOR_THREAD_SLEEP_TIME);
+
+		uint32_t iStartCycles = k_cycle_get_32();
+
+		/* Publish once; zbus delivers to every observer */
+		if (zbus_chan_pub(&imuChan, &decimatedStruct, IMU_PUB_TIMEOUT) != 0) {
+			LOG_WRN("IMU publish failed, dropping data");
+			continue;
+		}
+
+		latencyRecord(LATENCY_STAGE_ENQUEUE, iStartCycles);
 	}
 
 	/* This line will never be reached */
@@ -0,0 +1,252 @@
+/*
+ * @file latency_profiler.c
+ * @author Dhruv Mamtora
+ * @version 0.1.0
+ * @date  18 October, 2026
+ *
+ * @brief Per-stage latency histograms for the IMU-to-flash path.
+ *
+ * @details
+ * Each stage boundary (latencyStage_t) takes a k_cycle_get_32() stamp at its start and calls
+ * latencyRecord() at its end. The elapsed cycles land in a fixed log2 histogram: bucket n
+ * counts durations of [2^n, 2^(n+1)) cycles. Recording is one cycle counter read, a count
+ * leading zeros and two atomic operations, with no locks and no division, so it stays enabled
+ * in production builds.
+ *
+ * "sensor latency" prints count, median, 99th percentile and maximum of every stage,
+ * "sensor latency <stage>" the full histogram of one stage and "sensor latency reset" clears
+ * all of them. Percentiles are bucket upper bounds, so they are accurate to a factor of two.
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+/** REQUIRED HEADER FILES */
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/sys/atomic.h>
+
+#include <string.h>
+
+#include "sensor_structures.h"
+
+/** MACRO DEFINITIONS */
+/* One bucket per bit of the 32-bit cycle counter */
+#define LATENCY_BUCKETS 32
+
+/* Width of the longest histogram bar */
+#define LATENCY_BAR_WIDTH 40
+
+/* Function prototypes */
+void latencyRecord(latencyStage_t eStage, uint32_t iStartCycles);
+
+/** LOGGING CONFIGURATION */
+/* Register the logging module for the latency profiler. */
+LOG_MODULE_REGISTER(latency_profiler);
+
+typedef struct {
+	atomic_t iBuckets[LATENCY_BUCKETS];
+	atomic_t iMaxCycles;
+} latencyHistogram_t;
+
+/** GLOBAL VARIABLES */
+static latencyHistogram_t latencyHistograms[LATENCY_STAGE_COUNT];
+
+static const char *const cStageNames[LATENCY_STAGE_COUNT] = {
+	[LATENCY_STAGE_FETCH] = "fetch",
+	[LATENCY_STAGE_CONVERT] = "convert",
+	[LATENCY_STAGE_ENQUEUE] = "enqueue",
+	[LATENCY_STAGE_DEQUEUE] = "dequeue",
+	[LATENCY_STAGE_FORMAT] = "format",
+	[LATENCY_STAGE_FS_WRITE] = "fs_write",
+	[LATENCY_STAGE_FS_SYNC] = "fs_sync",
+	[LATENCY_STAGE_FS_CLOSE] = "fs_close",
+};
+
+/*
+ * @brief latencyRecord - Add the time since a start stamp to a stage histogram.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @details
+ * Safe from any thread or ISR. The maximum is updated with a compare-and-swap loop that only
+ * runs when a new maximum is seen.
+ *
+ * @syntax
+ * void latencyRecord(latencyStage_t eStage, uint32_t iStartCycles);
+ *
+ * @param[in] eStage Stage that just ended.
+ * @param[in] iStartCycles k_cycle_get_32() taken when the stage started.
+ *
+ * @return None.
+ */
+void latencyRecord(latencyStage_t eStage, uint32_t iStartCycles)
+{
+	uint32_t iCycles = k_cycle_get_32() - iStartCycles;
+	latencyHistogram_t *pHistogram = &latencyHistograms[eStage];
+	int iBucket = (iCycles == 0) ? 0 : 31 - __builtin_clz(iCycles);
+
+	atomic_inc(&pHistogram->iBuckets[iBucket]);
+
+	atomic_val_t iMax = atomic_get(&pHistogram->iMaxCycles);
+
+	while (iCycles > (uint32_t)iMax &&
+	       !atomic_cas(&pHistogram->iMaxCycles, iMax, (atomic_val_t)iCycles)) {
+		iMax = atomic_get(&pHistogram->iMaxCycles);
+	}
+}
+
+/*
+ * @brief latencyCyclesToUs - Convert a cycle count to microseconds.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @syntax
+ * static uint32_t latencyCyclesToUs(uint64_t iCycles);
+ *
+ * @param[in] iCycles Hardware cycles.
+ *
+ * @return Microseconds, rounded up so that short stages do not show as 0.
+ */
+static uint32_t latencyCyclesToUs(uint64_t iCycles)
+{
+	return (uint32_t)k_cyc_to_us_ceil64(iCycles);
+}
+
+/*
+ * @brief latencyPercentileUs - Upper bound of the bucket holding a percentile.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @syntax
+ * static uint32_t latencyPercentileUs(const uint32_t *pCounts, uint32_t iTotal,
+ *				       uint32_t iPercent);
+ *
+ * @param[in] pCounts Snapshot of the stage's bucket counts.
+ * @param[in] iTotal Sum of pCounts.
+ * @param[in] iPercent Percentile to look up (1..100).
+ *
+ * @return The percentile in microseconds, or 0 without samples.
+ */
+static uint32_t latencyPercentileUs(const uint32_t *pCounts, uint32_t iTotal, uint32_t iPercent)
+{
+	uint64_t iTarget = ((uint64_t)iTotal * iPercent + 99) / 100;
+	uint64_t iSeen = 0;
+
+	for (int iBucket = 0; iBucket < LATENCY_BUCKETS; iBucket++) {
+		iSeen += pCounts[iBucket];
+		if (iTotal > 0 && iSeen >= iTarget) {
+			return latencyCyclesToUs(BIT64(iBucket + 1));
+		}
+	}
+
+	return 0;
+}
+
+/*
+ * @brief latencySnapshot - Copy the bucket counts of one stage.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @syntax
+ * static uint32_t latencySnapshot(latencyStage_t eStage, uint32_t *pCounts);
+ *
+ * @param[in] eStage Stage to copy.
+ * @param[out] pCounts LATENCY_BUCKETS counts.
+ *
+ * @return Number of samples in the snapshot.
+ */
+static uint32_t latencySnapshot(latencyStage_t eStage, uint32_t *pCounts)
+{
+	uint32_t iTotal = 0;
+
+	for (int iBucket = 0; iBucket < LATENCY_BUCKETS; iBucket++) {
+		pCounts[iBucket] = (uint32_t)atomic_get(&latencyHistograms[eStage].iBuckets[iBucket]);
+		iTotal += pCounts[iBucket];
+	}
+
+	return iTotal;
+}
+
+static void shellLatencySummary(const struct shell *sh)
+{
+	uint32_t iCounts[LATENCY_BUCKETS];
+
+	shell_print(sh, "%-10s %10s %10s %10s %10s", "stage", "count", "p50 us", "p99 us", "max us");
+
+	for (int iStage = 0; iStage < LATENCY_STAGE_COUNT; iStage++) {
+		uint32_t iTotal = latencySnapshot(iStage, iCounts);
+
+		shell_print(sh, "%-10s %10u %10u %10u %10u", cStageNames[iStage], iTotal,
+			    latencyPercentileUs(iCounts, iTotal, 50),
+			    latencyPercentileUs(iCounts, iTotal, 99),
+			    latencyCyclesToUs((uint32_t)atomic_get(
+				    &latencyHistograms[iStage].iMaxCycles)));
+	}
+}
+
+static void shellLatencyHistogram(const struct shell *sh, latencyStage_t eStage)
+{
+	uint32_t iCounts[LATENCY_BUCKETS];
+	uint32_t iPeak = 0;
+	char cBar[LATENCY_BAR_WIDTH + 1];
+
+	latencySnapshot(eStage, iCounts);
+
+	for (int iBucket = 0; iBucket < LATENCY_BUCKETS; iBucket++) {
+		iPeak = MAX(iPeak, iCounts[iBucket]);
+	}
+
+	shell_print(sh, "%s (%u cycles/s)", cStageNames[eStage], sys_clock_hw_cycles_per_sec());
+
+	for (int iBucket = 0; iBucket < LATENCY_BUCKETS; iBucket++) {
+		if (iCounts[iBucket] == 0) {
+			continue;
+		}
+
+		uint32_t iWidth = (uint32_t)(((uint64_t)iCounts[iBucket] * LATENCY_BAR_WIDTH +
+					      iPeak - 1) / iPeak);
+
+		memset(cBar, '#', iWidth);
+		cBar[iWidth] = '\0';
+		shell_print(sh, "<%8u us %10u %s", latencyCyclesToUs(BIT64(iBucket + 1)),
+			    iCounts[iBucket], cBar);
+	}
+}
+
+static int shellLatency(const struct shell *sh, size_t argc, char **argv)
+{
+	if (argc == 1) {
+		shellLatencySummary(sh);
+		return 0;
+	}
+
+	if (strcmp(argv[1], "reset") == 0) {
+		for (int iStage = 0; iStage < LATENCY_STAGE_COUNT; iStage++) {
+			for (int iBucket = 0; iBucket < LATENCY_BUCKETS; iBucket++) {
+				atomic_clear(&latencyHistograms[iStage].iBuckets[iBucket]);
+			}
+			atomic_clear(&latencyHistograms[iStage].iMaxCycles);
+		}
+
+		shell_print(sh, "latency histograms cleared");
+		return 0;
+	}
+
+	for (int iStage = 0; iStage < LATENCY_STAGE_COUNT; iStage++) {
+		if (strcmp(argv[1], cStageNames[iStage]) == 0) {
+			shellLatencyHistogram(sh, iStage);
+			return 0;
+		}
+	}
+
+	shell_error(sh, "usage: sensor latency [reset|<stage>]");
+	return -EINVAL;
+}
+
+SHELL_SUBCMD_ADD((sensor), latency, NULL,
+		 "Show pipeline stage latencies: latency [reset|<stage>]", shellLatency, 1, 1);
@@ -0,0 +1,179 @@
+/*
+ * @file log_bench.c
+ * @author Dhruv Mamtora
+ * @version 0.1.0
+ * @date  18 October, 2026
+ *
+ * @brief Cost of the sensor log messages to the thread that logs them.
+ *
+ * @details
+ * "sensor logbench [count]" issues each message of printData() (sensor_logger.c) count times
+ * with fixed values and prints, per message, the average and worst cycles spent inside
+ * LOG_INF(), then the time the log thread needed to drain what was queued.
+ *
+ * In deferred mode the caller only packages the format string pointer and the arguments;
+ * formatting happens later in the log thread (text output) or on the host (dictionary output,
+ * see tools/log_capture.py). The drain time therefore shows the difference between the two:
+ * with text output it also covers the float formatting and the longer lines on the UART. Build
+ * with -DEXTRA_CONF_FILE=text.conf for the text baseline.
+ *
+ * The loop never yields, so the log thread cannot drain while it runs. Messages are issued in
+ * batches that fill at most half of CONFIG_LOG_BUFFER_SIZE and each batch is drained before the
+ * next, so the buffer does not overflow and the timings never include the overflow path. The
+ * peak fill level is printed; drops are reported by the log thread itself.
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+/** REQUIRED HEADER FILES */
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/logging/log_ctrl.h>
+#include <zephyr/shell/shell.h>
+
+#include <stdlib.h>
+
+/** MACRO DEFINITIONS */
+#define LOG_BENCH_DEFAULT_COUNT 20
+/* Rounds of the five sensor messages per run */
+#define LOG_BENCH_MAX_COUNT     200
+/* Log buffer space of a message with three doubles, rounded up */
+#define LOG_BENCH_MSG_SIZE      64
+#define LOG_BENCH_DRAIN_MS      10000
+
+/** LOGGING CONFIGURATION */
+/* Register the logging module for the log benchmark. */
+LOG_MODULE_REGISTER(log_bench);
+
+typedef struct {
+	uint32_t iTotal;
+	uint32_t iMax;
+} logBenchCycles_t;
+
+/*
+ * @brief logBenchRecord - Add one LOG_INF() call to the totals.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @syntax
+ * static void logBenchRecord(logBenchCycles_t *pCycles, uint32_t iStart);
+ *
+ * @param[in,out] pCycles Totals of the message.
+ * @param[in] iStart k_cycle_get_32() before the call.
+ *
+ * @return None.
+ */
+static void logBenchRecord(logBenchCycles_t *pCycles, uint32_t iStart)
+{
+	uint32_t iCycles = k_cycle_get_32() - iStart;
+
+	pCycles->iTotal += iCycles;
+	pCycles->iMax = MAX(pCycles->iMax, iCycles);
+}
+
+/*
+ * @brief logBenchDrain - Wait for the log thread to empty the log buffer.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @syntax
+ * static bool logBenchDrain(uint32_t *pDrainMs);
+ *
+ * @param[in,out] pDrainMs Time spent waiting is added here.
+ *
+ * @return true if the buffer drained within LOG_BENCH_DRAIN_MS.
+ */
+static bool logBenchDrain(uint32_t *pDrainMs)
+{
+	int64_t iStart = k_uptime_get();
+
+	while (log_data_pending() && k_uptime_get() - iStart < LOG_BENCH_DRAIN_MS) {
+		k_msleep(1);
+	}
+
+	*pDrainMs += (uint32_t)(k_uptime_get() - iStart);
+	return !log_data_pending();
+}
+
+static int shellLogBench(const struct shell *sh, size_t argc, char **argv)
+{
+	static const char *const cNames[] = {"humidity", "temperature", "pressure", "accel",
+					     "gyro"};
+	logBenchCycles_t cycles[ARRAY_SIZE(cNames)] = {0};
+	int iCount = LOG_BENCH_DEFAULT_COUNT;
+	int iBatch = MAX(CONFIG_LOG_BUFFER_SIZE / 2 / (ARRAY_SIZE(cNames) * LOG_BENCH_MSG_SIZE), 1);
+	uint32_t iBufSize = 0;
+	uint32_t iPeak = 0;
+	uint32_t iDrainMs = 0;
+	uint32_t iUsed;
+	uint32_t iStart;
+	bool bDrained;
+	int iDone = 0;
+
+	if (argc > 1) {
+		iCount = CLAMP(atoi(argv[1]), 1, LOG_BENCH_MAX_COUNT);
+	}
+
+	/* Start from an empty buffer so the drain time only covers this run */
+	if (!logBenchDrain(&iDrainMs)) {
+		shell_error(sh, "log buffer does not drain");
+		return -EBUSY;
+	}
+	iDrainMs = 0;
+
+	do {
+		for (int iNum = 0; iNum < iBatch && iDone < iCount; iNum++, iDone++) {
+			iStart = k_cycle_get_32();
+			LOG_INF("Humidity: %.2f %%", 45.67);
+			logBenchRecord(&cycles[0], iStart);
+
+			iStart = k_cycle_get_32();
+			LOG_INF("Temperature: %.2f C", 23.45);
+			logBenchRecord(&cycles[1], iStart);
+
+			iStart = k_cycle_get_32();
+			LOG_INF("Pressure: %.2f hPa", 1013.25);
+			logBenchRecord(&cycles[2], iStart);
+
+			iStart = k_cycle_get_32();
+			LOG_INF("Accelerometer: X=%.2f Y=%.2f Z=%.2f", 0.12, -0.05, 9.81);
+			logBenchRecord(&cycles[3], iStart);
+
+			iStart = k_cycle_get_32();
+			LOG_INF("Gyroscope: X=%.2f Y=%.2f Z=%.2f", 0.01, -0.02, 0.00);
+			logBenchRecord(&cycles[4], iStart);
+		}
+
+		/* Fill level before the log thread gets to run */
+		if (log_mem_get_usage(&iBufSize, &iUsed) == 0) {
+			iPeak = MAX(iPeak, iUsed);
+		}
+		bDrained = logBenchDrain(&iDrainMs);
+	} while (bDrained && iDone < iCount);
+
+	shell_print(sh, "%-12s %10s %10s %10s", "message", "avg cyc", "max cyc", "avg ns");
+	for (int iNum = 0; iNum < ARRAY_SIZE(cNames); iNum++) {
+		uint32_t iAvg = cycles[iNum].iTotal / iDone;
+
+		shell_print(sh, "%-12s %10u %10u %10u", cNames[iNum], iAvg, cycles[iNum].iMax,
+			    (uint32_t)k_cyc_to_ns_floor64(iAvg));
+	}
+	shell_print(sh, "%d messages in batches of %d drained in %u ms%s",
+		    iDone * (int)ARRAY_SIZE(cNames), iBatch * (int)ARRAY_SIZE(cNames), iDrainMs,
+		    bDrained ? "" : " (still pending)");
+	if (iBufSize > 0) {
+		bool bFull = iPeak + LOG_BENCH_MSG_SIZE > iBufSize;
+
+		/* The log thread reports the count as "--- N messages dropped ---" */
+		shell_print(sh, "log buffer peak %u of %u B%s", iPeak, iBufSize,
+			    bFull ? ", full: messages may have been dropped" : "");
+	}
+
+	return 0;
+}
+
+SHELL_SUBCMD_ADD((sensor), logbench, NULL,
+		 "Time the sensor log messages: logbench [count], count up to 200", shellLogBench,
+		 1, 1);
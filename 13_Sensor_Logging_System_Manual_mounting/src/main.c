@@ -15,10 +15,15 @@
 /** REQUIRED HEADER FILES */
 #include <zephyr/logging/log.h>
 #include <zephyr/kernel.h>
+#include <zephyr/shell/shell.h>
 
 /* Register the logging module for main application */
 LOG_MODULE_REGISTER(main);
 
+/* Root "sensor" shell command; each module adds its own subcommands with SHELL_SUBCMD_ADD */
+SHELL_SUBCMD_SET_CREATE(subSensor, (sensor));
+SHELL_CMD_REGISTER(sensor, &subSensor, "Sensor logging commands", NULL);
+
 /*
  * @brief main - Main function.
  *
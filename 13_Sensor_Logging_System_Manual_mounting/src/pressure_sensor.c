@@ -8,35 +8,103 @@
  *
  * @details
  * This file contains the implementation of the pressure sensor thread, which reads data from
- * the LPS22HH sensor and sends the pressure data to the logger thread via a message queue
- * for logging.
+ * the LPS22HH sensor and publishes the pressure data on pressureChan for the logger and other
+ * observers.
+ *
+ * The producer supports three acquisition modes:
+ * - PRESSURE_MODE_CONTINUOUS: sensor free-runs at the driver ODR, one fetch per wakeup.
+ * - PRESSURE_MODE_ONE_SHOT: sensor stays powered down and converts once per wakeup.
+ *   Intended for low-rate logging.
+ * - PRESSURE_MODE_FIFO: sensor runs at PRESSURE_FIFO_ODR with the hardware low-pass filter
+ *   into its 32-level FIFO; each wakeup drains all stored samples with one burst read.
+ *   Intended for 10-75 Hz capture.
  *
  * @copyright Copyright (c) 2025
  */
 
 /** REQUIRED HEADER FILES */
 #include <zephyr/device.h>
+#include <zephyr/drivers/i2c.h>
 #include <zephyr/drivers/sensor.h>
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/zbus/zbus.h>
 
 #include "sensor_structures.h"
 
 /** MACRO DEFINITIONS */
-#define PRESSURE_SENSOR_THREAD_STACK_SIZE 512
+#define PRESSURE_SENSOR_THREAD_STACK_SIZE 1024
 #define PRESSURE_SENSOR_THREAD_PRIORITY   5
 #define PRESSURE_SENSOR_THREAD_SLEEP_TIME K_SECONDS(30)
 
-#define PRESSURE_Q_MAX_MSGS 10
-#define PRESSURE_Q_ALIGN    32
+#define PRESSURE_PUB_TIMEOUT K_MSEC(100)
+
+/* Acquisition mode, see pressureMode_t */
+#define PRESSURE_SENSOR_MODE PRESSURE_MODE_ONE_SHOT
+
+/* FIFO mode: 25 Hz ODR, drained every second (25 of 32 slots) */
+#define PRESSURE_FIFO_ODR         LPS22HB_ODR_25HZ
+#define PRESSURE_FIFO_DRAIN_TIME  K_MSEC(1000)
+#define PRESSURE_FIFO_DEPTH       32
+
+/* One-shot conversion poll: typ. < 40 ms with the filter off */
+#define PRESSURE_ONE_SHOT_POLL_TIME K_MSEC(5)
+#define PRESSURE_ONE_SHOT_RETRIES   20
 
-#define PRESSURE_Q_TIMEOUT K_MSEC(1000)
+/* LPS22HB register map */
+#define LPS22HB_REG_CTRL_REG1    0x10
+#define LPS22HB_REG_CTRL_REG2    0x11
+#define LPS22HB_REG_FIFO_CTRL    0x14
+#define LPS22HB_REG_FIFO_STATUS  0x26
+#define LPS22HB_REG_STATUS       0x27
+#define LPS22HB_REG_PRESS_OUT_XL 0x28
+
+#define LPS22HB_ODR_SHIFT          4
+#define LPS22HB_ODR_POWER_DOWN     0
+#define LPS22HB_ODR_25HZ           3
+#define LPS22HB_CTRL_REG1_EN_LPFP  BIT(3)
+#define LPS22HB_CTRL_REG1_LPFP_CFG BIT(2)
+#define LPS22HB_CTRL_REG1_BDU      BIT(1)
+#define LPS22HB_CTRL_REG2_FIFO_EN  BIT(6)
+#define LPS22HB_CTRL_REG2_ADD_INC  BIT(4)
+#define LPS22HB_CTRL_REG2_ONE_SHOT BIT(0)
+#define LPS22HB_FIFO_MODE_BYPASS   (0 << 5)
+#define LPS22HB_FIFO_MODE_STREAM   (2 << 5)
+#define LPS22HB_FIFO_STATUS_FSS    0x3F
+#define LPS22HB_STATUS_P_DA        BIT(0)
+
+/* ODR the driver programs at init (CONFIG_LPS22HB_SAMPLING_RATE), restored in continuous mode */
+#if CONFIG_LPS22HB_SAMPLING_RATE == 1
+#define LPS22HB_ODR_DRIVER 1
+#elif CONFIG_LPS22HB_SAMPLING_RATE == 10
+#define LPS22HB_ODR_DRIVER 2
+#elif CONFIG_LPS22HB_SAMPLING_RATE == 50
+#define LPS22HB_ODR_DRIVER 4
+#elif CONFIG_LPS22HB_SAMPLING_RATE == 75
+#define LPS22HB_ODR_DRIVER 5
+#else
+#define LPS22HB_ODR_DRIVER 3
+#endif
+
+/* One FIFO slot holds PRESS_OUT_XL/L/H and TEMP_OUT_L/H */
+#define LPS22HB_FIFO_SLOT_SIZE 5
+
+/* Raw pressure is 4096 LSB/hPa; report kPa like SENSOR_CHAN_PRESS */
+#define LPS22HB_LSB_PER_KPA 40960.0
+
+typedef enum {
+	PRESSURE_MODE_CONTINUOUS,
+	PRESSURE_MODE_ONE_SHOT,
+	PRESSURE_MODE_FIFO,
+} pressureMode_t;
 
 /** DEVICE CONFIGURATION */
 /* Check if the LPS22HH sensor is defined in the device tree. */
 #if DT_NODE_EXISTS(DT_ALIAS(pressure_sensor))
 #define PRESSURE_NODE DT_ALIAS(pressure_sensor)
 const struct device *const pressureDev = DEVICE_DT_GET(DT_ALIAS(pressure_sensor));
+static const struct i2c_dt_spec pressureBus = I2C_DT_SPEC_GET(PRESSURE_NODE);
 #else
 #error ("Pressure sensor not found.");
 #endif
@@ -44,13 +112,195 @@ const struct device *const pressureDev = DEVICE_DT_GET(DT_ALIAS(pressure_sensor)
 /* Function prototypes */
 void pressureSensorThread(void *a, void *b, void *c);
 int pressureSensorProcess(pressureData_t *pressureDataStruct);
+int pressureSensorSetMode(pressureMode_t eMode);
+int pressureSensorDrainFifo(pressureData_t *pressureSamples, int iMaxSamples);
 
 /** LOGGING CONFIGURATION */
 /* Register the logging module for pressure sensor operations. */
 LOG_MODULE_REGISTER(pressure);
 
-/* Message queue to send pressure data to the logger thread */
-K_MSGQ_DEFINE(pressureMsgQ, sizeof(pressureData_t), PRESSURE_Q_MAX_MSGS, PRESSURE_Q_ALIGN);
+/* Channel for pressure samples, defined in sensor_channels.c */
+ZBUS_CHAN_DECLARE(pressureChan);
+
+/* Current acquisition mode, only changed through pressureSensorSetMode() */
+static pressureMode_t ePressureMode = PRESSURE_MODE_CONTINUOUS;
+
+/*
+ * @brief pressureRawToKpa - Convert a 24-bit little-endian LPS22HB pressure sample.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @syntax
+ * static double pressureRawToKpa(const uint8_t *pRaw);
+ *
+ * @param[in] pRaw Pointer to PRESS_OUT_XL, PRESS_OUT_L, PRESS_OUT_H.
+ *
+ * @return Pressure in kPa.
+ */
+static double pressureRawToKpa(const uint8_t *pRaw)
+{
+	/* sign-extend the two's complement 24-bit value */
+	int32_t iRaw = ((int32_t)(sys_get_le24(pRaw) << 8)) >> 8;
+
+	return iRaw / LPS22HB_LSB_PER_KPA;
+}
+
+/*
+ * @brief pressureSensorSetMode - Reconfigure the LPS22HB acquisition mode.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @details
+ * One-shot mode powers the sensor down between conversions. FIFO mode runs the sensor at
+ * PRESSURE_FIFO_ODR with the low-pass filter (ODR/20) in stream mode, so the FIFO always
+ * holds the newest samples. Continuous mode restores the driver's ODR with the FIFO bypassed,
+ * undoing either of the other two.
+ *
+ * @pre The sensor device must be initialized and ready.
+ *
+ * @syntax
+ * int pressureSensorSetMode(pressureMode_t eMode);
+ *
+ * @param[in] eMode Requested acquisition mode.
+ *
+ * @return 0 on success, -1 on failure.
+ *
+ * @retval 0 Success
+ * @retval -1 Error
+ */
+int pressureSensorSetMode(pressureMode_t eMode)
+{
+	uint8_t iCtrl1 = LPS22HB_CTRL_REG1_BDU;
+	uint8_t iCtrl2 = LPS22HB_CTRL_REG2_ADD_INC;
+	uint8_t iFifoCtrl = LPS22HB_FIFO_MODE_BYPASS;
+
+	if (eMode == PRESSURE_MODE_FIFO) {
+		iCtrl1 |= (PRESSURE_FIFO_ODR << LPS22HB_ODR_SHIFT) | LPS22HB_CTRL_REG1_EN_LPFP |
+			  LPS22HB_CTRL_REG1_LPFP_CFG;
+		iCtrl2 |= LPS22HB_CTRL_REG2_FIFO_EN;
+		iFifoCtrl = LPS22HB_FIFO_MODE_STREAM;
+	} else if (eMode == PRESSURE_MODE_CONTINUOUS) {
+		iCtrl1 |= LPS22HB_ODR_DRIVER << LPS22HB_ODR_SHIFT;
+	} else {
+		iCtrl1 |= LPS22HB_ODR_POWER_DOWN << LPS22HB_ODR_SHIFT;
+	}
+
+	/* Power down first so the FIFO is reset with the new configuration */
+	if (i2c_reg_write_byte_dt(&pressureBus, LPS22HB_REG_CTRL_REG1, LPS22HB_CTRL_REG1_BDU) < 0 ||
+	    i2c_reg_write_byte_dt(&pressureBus, LPS22HB_REG_FIFO_CTRL, iFifoCtrl) < 0 ||
+	    i2c_reg_write_byte_dt(&pressureBus, LPS22HB_REG_CTRL_REG2, iCtrl2) < 0 ||
+	    i2c_reg_write_byte_dt(&pressureBus, LPS22HB_REG_CTRL_REG1, iCtrl1) < 0) {
+		LOG_ERR("Cannot configure pressure sensor mode %d", eMode);
+		return -1;
+	}
+
+	ePressureMode = eMode;
+	return 0;
+}
+
+/*
+ * @brief pressureSensorOneShot - Trigger and read a single LPS22HB conversion.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @pre pressureSensorSetMode(PRESSURE_MODE_ONE_SHOT) must have succeeded.
+ *
+ * @syntax
+ * static int pressureSensorOneShot(pressureData_t *pressureDataStruct);
+ *
+ * @param[out] pressureDataStruct->dPressure Updated with the converted value in kPa.
+ *
+ * @return 0 on success, -1 on failure.
+ */
+static int pressureSensorOneShot(pressureData_t *pressureDataStruct)
+{
+	uint8_t iStatus = 0;
+	uint8_t iRaw[3];
+
+	if (i2c_reg_write_byte_dt(&pressureBus, LPS22HB_REG_CTRL_REG2,
+				  LPS22HB_CTRL_REG2_ADD_INC | LPS22HB_CTRL_REG2_ONE_SHOT) < 0) {
+		LOG_ERR("Cannot start one-shot conversion");
+		return -1;
+	}
+
+	for (int iRetry = 0; iRetry < PRESSURE_ONE_SHOT_RETRIES; iRetry++) {
+		k_sleep(PRESSURE_ONE_SHOT_POLL_TIME);
+		if (i2c_reg_read_byte_dt(&pressureBus, LPS22HB_REG_STATUS, &iStatus) < 0) {
+			LOG_ERR("Cannot read pressure status");
+			return -1;
+		}
+		if (iStatus & LPS22HB_STATUS_P_DA) {
+			break;
+		}
+	}
+
+	if (!(iStatus & LPS22HB_STATUS_P_DA)) {
+		LOG_ERR("One-shot conversion timed out");
+		return -1;
+	}
+
+	if (i2c_burst_read_dt(&pressureBus, LPS22HB_REG_PRESS_OUT_XL, iRaw, sizeof(iRaw)) < 0) {
+		LOG_ERR("Cannot read pressure output");
+		return -1;
+	}
+
+	pressureDataStruct->dPressure = pressureRawToKpa(iRaw);
+	return 0;
+}
+
+/*
+ * @brief pressureSensorDrainFifo - Read every sample stored in the LPS22HB FIFO.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @details
+ * Reads the FIFO level, then fetches all stored slots with a single I2C burst. With the FIFO
+ * enabled the output register address rolls back from TEMP_OUT_H to PRESS_OUT_XL, so one
+ * transfer returns consecutive 5-byte slots.
+ *
+ * @pre pressureSensorSetMode(PRESSURE_MODE_FIFO) must have succeeded.
+ *
+ * @syntax
+ * int pressureSensorDrainFifo(pressureData_t *pressureSamples, int iMaxSamples);
+ *
+ * @param[out] pressureSamples Array receiving the samples, oldest first.
+ * @param[in] iMaxSamples Capacity of pressureSamples.
+ *
+ * @return Number of samples read, or -1 on failure.
+ */
+int pressureSensorDrainFifo(pressureData_t *pressureSamples, int iMaxSamples)
+{
+	uint8_t iRaw[PRESSURE_FIFO_DEPTH * LPS22HB_FIFO_SLOT_SIZE];
+	uint8_t iFifoStatus;
+	int iLevel;
+
+	if (i2c_reg_read_byte_dt(&pressureBus, LPS22HB_REG_FIFO_STATUS, &iFifoStatus) < 0) {
+		LOG_ERR("Cannot read pressure FIFO status");
+		return -1;
+	}
+
+	iLevel = MIN(iFifoStatus & LPS22HB_FIFO_STATUS_FSS, MIN(iMaxSamples, PRESSURE_FIFO_DEPTH));
+	if (iLevel == 0) {
+		return 0;
+	}
+
+	if (i2c_burst_read_dt(&pressureBus, LPS22HB_REG_PRESS_OUT_XL, iRaw,
+			      iLevel * LPS22HB_FIFO_SLOT_SIZE) < 0) {
+		LOG_ERR("Cannot read pressure FIFO");
+		return -1;
+	}
+
+	for (int iNum = 0; iNum < iLevel; iNum++) {
+		pressureSamples[iNum].dPressure =
+			pressureRawToKpa(&iRaw[iNum * LPS22HB_FIFO_SLOT_SIZE]);
+	}
+
+	return iLevel;
+}
 
 /*
  * @brief pressureSensorProcess - Process pressure sensor data.
@@ -60,7 +310,8 @@ K_MSGQ_DEFINE(pressureMsgQ, sizeof(pressureData_t), PRESSURE_Q_MAX_MSGS, PRESSUR
  *
  * @details
  * This function reads data from the LPS22HH pressure sensor and updates the provided
- * pressureDataStruct with the latest pressure value.
+ * pressureDataStruct with the latest pressure value. In one-shot mode a single conversion is
+ * triggered and read back; otherwise the driver's latest sample is fetched.
  *
  * @pre The sensor device must be initialized and ready.
  *
@@ -68,7 +319,7 @@ K_MSGQ_DEFINE(pressureMsgQ, sizeof(pressureData_t), PRESSURE_Q_MAX_MSGS, PRESSUR
  * int pressureSensorProcess(pressureData_t *pressureDataStruct);
  *
  * @param[in] pressureDataStruct Pointer to the structure to store the latest pressure value.
- * @param[out] pressureDataStruct->dPressure Updated with the latest pressure value in hPa.
+ * @param[out] pressureDataStruct->dPressure Updated with the latest pressure value in kPa.
  *
  * @return 0 on success, -1 on failure.
  *
@@ -82,6 +333,10 @@ int pressureSensorProcess(pressureData_t *pressureDataStruct)
 		return -1;
 	}
 
+	if (ePressureMode == PRESSURE_MODE_ONE_SHOT) {
+		return pressureSensorOneShot(pressureDataStruct);
+	}
+
 	if (sensor_sample_fetch(pressureDev) < 0) {
 		LOG_ERR("Sensor sample update error");
 		return -1;
@@ -105,7 +360,8 @@ int pressureSensorProcess(pressureData_t *pressureDataStruct)
  *
  * @details
  * This thread function continuously reads data from the LPS22HH pressure sensor at defined
- * intervals and sends the data to the logger thread via a message queue.
+ * intervals and publishes the data on pressureChan. In FIFO mode each wakeup drains the whole
+ * hardware FIFO and publishes every sample without blocking.
  *
  * @syntax
  * void pressureSensorThread(void *a, void *b, void *c);
@@ -117,14 +373,40 @@ int pressureSensorProcess(pressureData_t *pressureDataStruct)
 void pressureSensorThread(void *a, void *b, void *c)
 {
 	pressureData_t pressureDataStruct;
+	static pressureData_t pressureSamples[PRESSURE_FIFO_DEPTH];
+
+	if (!device_is_ready(pressureDev) || pressureSensorSetMode(PRESSURE_SENSOR_MODE) != 0) {
+		LOG_WRN("Falling back to continuous pressure acquisition.");
+	}
 
 	LOG_INF("Pressure sensor thread started.");
 	while (1) {
+		if (ePressureMode == PRESSURE_MODE_FIFO) {
+			int iCount = pressureSensorDrainFifo(pressureSamples, PRESSURE_FIFO_DEPTH);
+			int iDropped = 0;
+
+			/* Never block with samples in hand: the FIFO keeps filling meanwhile */
+			for (int iNum = 0; iNum < iCount; iNum++) {
+				if (zbus_chan_pub(&pressureChan, &pressureSamples[iNum], K_NO_WAIT) !=
+				    0) {
+					iDropped++;
+				}
+			}
+
+			if (iDropped > 0) {
+				LOG_WRN("Pressure publish failed, dropped %d of %d samples.",
+					iDropped, iCount);
+			}
+
+			k_sleep(PRESSURE_FIFO_DRAIN_TIME);
+			continue;
+		}
+
 		if (pressureSensorProcess(&pressureDataStruct) == 0) {
-			/* Send the pressure data to the logger thread */
-			if (k_msgq_put(&pressureMsgQ, &pressureDataStruct, PRESSURE_Q_TIMEOUT) !=
+			/* Publish once; zbus delivers to every observer */
+			if (zbus_chan_pub(&pressureChan, &pressureDataStruct, PRESSURE_PUB_TIMEOUT) !=
 			    0) {
-				LOG_WRN("Pressure message queue full, dropping data.");
+				LOG_WRN("Pressure publish failed, dropping data.");
 			}
 		}
 		k_sleep(PRESSURE_SENSOR_THREAD_SLEEP_TIME);
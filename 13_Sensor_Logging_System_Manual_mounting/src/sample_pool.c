@@ -0,0 +1,240 @@
+/*
+ * @file sample_pool.c
+ * @author Dhruv Mamtora
+ * @version 0.1.0
+ * @date  18 October, 2026
+ *
+ * @brief Reference-counted blocks of full-rate IMU samples for zero-copy fan-out.
+ *
+ * @details
+ * The IMU thread fills one sampleBlock_t from a k_mem_slab at a time. When the block is full
+ * a pointer to it is queued to every consumer and each queued pointer holds one reference.
+ * Consumers call samplePoolRelease() when done and the block goes back to the slab with the
+ * last release, so the samples are copied exactly once however many consumers there are.
+ *
+ * Consumer queues are drop-newest streams (stream_queue.c): a consumer whose queue is full
+ * loses that block, counted as a drop on its stream, and the producer never waits. "sensor pool"
+ * shows pool usage, the high-water mark and the failure counters.
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+/** REQUIRED HEADER FILES */
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/sys/atomic.h>
+
+#include "sensor_structures.h"
+
+/** MACRO DEFINITIONS */
+/* Two seconds of data in flight */
+#define SAMPLE_POOL_BLOCKS 8
+#define SAMPLE_POOL_ALIGN  4
+
+/* Function prototypes */
+void samplePoolFeed(const motionData_t *motionDataStruct, uint32_t iTimestampMs);
+void samplePoolRelease(sampleBlock_t *pBlock);
+void samplePoolDiscard(void *pItem);
+int streamQueuePut(streamQueue_t *pStream, const void *pItem);
+
+/** LOGGING CONFIGURATION */
+/* Register the logging module for the sample pool. */
+LOG_MODULE_REGISTER(sample_pool);
+
+/* Consumer streams of sampleBlock_t pointers */
+extern streamQueue_t imuAnalyticsStream;
+extern streamQueue_t imuRawLogStream;
+
+/** GLOBAL VARIABLES */
+static streamQueue_t *const sampleConsumers[] = {
+	&imuAnalyticsStream,
+	&imuRawLogStream,
+};
+
+K_MEM_SLAB_DEFINE_STATIC(samplePoolSlab, sizeof(sampleBlock_t), SAMPLE_POOL_BLOCKS,
+			 SAMPLE_POOL_ALIGN);
+
+static atomic_t iBlocksInUse;
+static atomic_t iBlocksHighWater;
+static atomic_t iAllocFailures;
+static atomic_t iBlocksPublished;
+
+/* Block being filled, owned by the IMU thread */
+static sampleBlock_t *pFillBlock;
+static uint32_t iNextSequence;
+
+/*
+ * @brief samplePoolAlloc - Take a block from the slab with one reference.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @syntax
+ * static sampleBlock_t *samplePoolAlloc(void);
+ *
+ * @return Pointer to the block, or NULL when the pool is exhausted.
+ */
+static sampleBlock_t *samplePoolAlloc(void)
+{
+	void *pMem;
+
+	if (k_mem_slab_alloc(&samplePoolSlab, &pMem, K_NO_WAIT) != 0) {
+		atomic_inc(&iAllocFailures);
+		return NULL;
+	}
+
+	sampleBlock_t *pBlock = pMem;
+	atomic_val_t iInUse = atomic_inc(&iBlocksInUse) + 1;
+	atomic_val_t iHigh = atomic_get(&iBlocksHighWater);
+
+	while (iInUse > iHigh && !atomic_cas(&iBlocksHighWater, iHigh, iInUse)) {
+		iHigh = atomic_get(&iBlocksHighWater);
+	}
+
+	atomic_set(&pBlock->iRefCount, 1);
+	pBlock->iSequence = iNextSequence++;
+	pBlock->iCount = 0;
+	return pBlock;
+}
+
+/*
+ * @brief samplePoolRelease - Drop one reference to a block.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @details
+ * The last reference returns the block to the slab. Safe to call from any thread.
+ *
+ * @syntax
+ * void samplePoolRelease(sampleBlock_t *pBlock);
+ *
+ * @param[in] pBlock Block received from a consumer queue.
+ *
+ * @return None.
+ */
+void samplePoolRelease(sampleBlock_t *pBlock)
+{
+	if (atomic_dec(&pBlock->iRefCount) == 1) {
+		atomic_dec(&iBlocksInUse);
+		k_mem_slab_free(&samplePoolSlab, pBlock);
+	}
+}
+
+/*
+ * @brief samplePoolDiscard - Release a block pointer that a stream queue discarded.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @details
+ * Discard hook of the consumer streams: the drop_oldest and coalesce policies remove queued
+ * pointers without handing them to the consumer, so the reference each of them holds is
+ * dropped here.
+ *
+ * @syntax
+ * void samplePoolDiscard(void *pItem);
+ *
+ * @param[in] pItem Queue item, i.e. a pointer to a sampleBlock_t pointer.
+ *
+ * @return None.
+ */
+void samplePoolDiscard(void *pItem)
+{
+	samplePoolRelease(*(sampleBlock_t **)pItem);
+}
+
+/*
+ * @brief samplePoolPublish - Hand a full block to every consumer.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @details
+ * Takes a reference for each consumer before queueing the pointer, so a fast consumer cannot
+ * free the block while it is still being handed out, then drops the producer's reference.
+ *
+ * @syntax
+ * static void samplePoolPublish(sampleBlock_t *pBlock);
+ *
+ * @param[in] pBlock Filled block owned by the caller.
+ *
+ * @return None.
+ */
+static void samplePoolPublish(sampleBlock_t *pBlock)
+{
+	for (int iNum = 0; iNum < ARRAY_SIZE(sampleConsumers); iNum++) {
+		atomic_inc(&pBlock->iRefCount);
+
+		if (streamQueuePut(sampleConsumers[iNum], &pBlock) != 0) {
+			samplePoolRelease(pBlock);
+		}
+	}
+
+	atomic_inc(&iBlocksPublished);
+	samplePoolRelease(pBlock);
+}
+
+/*
+ * @brief samplePoolFeed - Append one full-rate IMU sample to the current block.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @details
+ * Called by the IMU thread for every sample. A new block is allocated on demand; while the
+ * pool is exhausted samples are skipped rather than stalling acquisition.
+ *
+ * @syntax
+ * void samplePoolFeed(const motionData_t *motionDataStruct, uint32_t iTimestampMs);
+ *
+ * @param[in] motionDataStruct Latest IMU sample.
+ * @param[in] iTimestampMs Uptime of the sample in milliseconds.
+ *
+ * @return None.
+ */
+void samplePoolFeed(const motionData_t *motionDataStruct, uint32_t iTimestampMs)
+{
+	if (pFillBlock == NULL) {
+		pFillBlock = samplePoolAlloc();
+		if (pFillBlock == NULL) {
+			return;
+		}
+	}
+
+	captureSample_t *pSample = &pFillBlock->samples[pFillBlock->iCount];
+
+	pSample->iTimestampMs = iTimestampMs;
+	pSample->fAccel[0] = motionDataStruct->accel.x;
+	pSample->fAccel[1] = motionDataStruct->accel.y;
+	pSample->fAccel[2] = motionDataStruct->accel.z;
+	pSample->fGyro[0] = motionDataStruct->gyro.x;
+	pSample->fGyro[1] = motionDataStruct->gyro.y;
+	pSample->fGyro[2] = motionDataStruct->gyro.z;
+
+	if (++pFillBlock->iCount == SAMPLE_BLOCK_SAMPLES) {
+		samplePoolPublish(pFillBlock);
+		pFillBlock = NULL;
+	}
+}
+
+static int shellPoolStats(const struct shell *sh, size_t argc, char **argv)
+{
+	shell_print(sh, "blocks: %u x %u bytes (%u samples each)", SAMPLE_POOL_BLOCKS,
+		    (uint32_t)sizeof(sampleBlock_t), SAMPLE_BLOCK_SAMPLES);
+	shell_print(sh, "in use: %ld, high-water: %ld", atomic_get(&iBlocksInUse),
+		    atomic_get(&iBlocksHighWater));
+	shell_print(sh, "published: %ld, allocation failures: %ld", atomic_get(&iBlocksPublished),
+		    atomic_get(&iAllocFailures));
+
+	for (int iNum = 0; iNum < ARRAY_SIZE(sampleConsumers); iNum++) {
+		shell_print(sh, "consumer %s: queued %u, dropped %ld", sampleConsumers[iNum]->cName,
+			    k_msgq_num_used_get(sampleConsumers[iNum]->pQueue),
+			    atomic_get(&sampleConsumers[iNum]->iDropped));
+	}
+
+	return 0;
+}
+
+SHELL_SUBCMD_ADD((sensor), pool, NULL, "Show IMU sample pool statistics", shellPoolStats, 1, 0);
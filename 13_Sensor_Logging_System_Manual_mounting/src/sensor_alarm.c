@@ -0,0 +1,90 @@
+/*
+ * @file sensor_alarm.c
+ * @author Dhruv Mamtora
+ * @version 0.1.0
+ * @date  18 October, 2026
+ *
+ * @brief Threshold alarms on the environmental sensor channels.
+ *
+ * @details
+ * A zbus listener on humChan and tempChan. The check is a couple of compares, so it runs
+ * synchronously in the publishing thread instead of needing its own thread and stack. Only
+ * transitions into and out of the alarm band are logged.
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+/** REQUIRED HEADER FILES */
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/zbus/zbus.h>
+
+#include "sensor_structures.h"
+
+/** MACRO DEFINITIONS */
+#define ALARM_HUMIDITY_MAX    80.0
+#define ALARM_TEMPERATURE_MIN 0.0
+#define ALARM_TEMPERATURE_MAX 40.0
+
+/** LOGGING CONFIGURATION */
+/* Register the logging module for sensor alarms. */
+LOG_MODULE_REGISTER(sensor_alarm);
+
+/* Sensor channels, defined in sensor_channels.c */
+ZBUS_CHAN_DECLARE(humChan, tempChan);
+
+/* Alarm state, only touched from the listener callback */
+static bool bHumidityAlarm;
+static bool bTemperatureAlarm;
+
+/*
+ * @brief sensorAlarmCallback - Check a new sample against the alarm thresholds.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @details
+ * Runs in the publisher's context with the channel locked, so the message is read in place
+ * with zbus_chan_const_msg() and the callback must not block.
+ *
+ * @syntax
+ * static void sensorAlarmCallback(const struct zbus_channel *chan);
+ *
+ * @param[in] chan Channel that was published.
+ *
+ * @return None.
+ */
+static void sensorAlarmCallback(const struct zbus_channel *chan)
+{
+	if (chan == &humChan) {
+		const humidityData_t *pHumidity = zbus_chan_const_msg(chan);
+		bool bAlarm = pHumidity->dHumidity > ALARM_HUMIDITY_MAX;
+
+		if (bAlarm != bHumidityAlarm) {
+			bHumidityAlarm = bAlarm;
+			if (bAlarm) {
+				LOG_WRN("Humidity alarm: %.1f %%", pHumidity->dHumidity);
+			} else {
+				LOG_INF("Humidity back in range: %.1f %%", pHumidity->dHumidity);
+			}
+		}
+	} else if (chan == &tempChan) {
+		const temperatureData_t *pTemperature = zbus_chan_const_msg(chan);
+		bool bAlarm = pTemperature->dTemperature < ALARM_TEMPERATURE_MIN ||
+			      pTemperature->dTemperature > ALARM_TEMPERATURE_MAX;
+
+		if (bAlarm != bTemperatureAlarm) {
+			bTemperatureAlarm = bAlarm;
+			if (bAlarm) {
+				LOG_WRN("Temperature alarm: %.1f C", pTemperature->dTemperature);
+			} else {
+				LOG_INF("Temperature back in range: %.1f C",
+					pTemperature->dTemperature);
+			}
+		}
+	}
+}
+
+ZBUS_LISTENER_DEFINE(sensorAlarmListener, sensorAlarmCallback);
+ZBUS_CHAN_ADD_OBS(humChan, sensorAlarmListener, 1);
+ZBUS_CHAN_ADD_OBS(tempChan, sensorAlarmListener, 1);
@@ -0,0 +1,164 @@
+/*
+ * @file sensor_channels.c
+ * @author Dhruv Mamtora
+ * @version 0.1.0
+ * @date  18 October, 2026
+ *
+ * @brief zbus channels carrying the sensor data model.
+ *
+ * @details
+ * Every sample type has one channel. Producers publish once and zbus fans the sample out to
+ * all observers, which are listeners running synchronously in the publisher's context. They
+ * must stay cheap: the alarm checker compares against its thresholds, and the flash logger's
+ * listener only copies the sample into a non-blocking stream queue (stream_queue.c) for the
+ * logger thread. Consumers attach themselves with ZBUS_CHAN_ADD_OBS(), so adding one never
+ * touches the producers.
+ *
+ * "sensor zbus bench" measures the publish latency of a motionData_t sized message with one,
+ * two and four listeners attached.
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+/** REQUIRED HEADER FILES */
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/zbus/zbus.h>
+
+#include <stdlib.h>
+
+#include "sensor_structures.h"
+
+/** MACRO DEFINITIONS */
+#define BENCH_OBSERVERS_MAX     4
+#define BENCH_DEFAULT_PUBLISHES 1000
+#define BENCH_PUB_TIMEOUT       K_MSEC(10)
+
+/** LOGGING CONFIGURATION */
+/* Register the logging module for the sensor channels. */
+LOG_MODULE_REGISTER(sensor_channels);
+
+/** CHANNEL DEFINITIONS */
+ZBUS_CHAN_DEFINE(humChan, humidityData_t, NULL, NULL, ZBUS_OBSERVERS_EMPTY, ZBUS_MSG_INIT(0));
+ZBUS_CHAN_DEFINE(tempChan, temperatureData_t, NULL, NULL, ZBUS_OBSERVERS_EMPTY, ZBUS_MSG_INIT(0));
+ZBUS_CHAN_DEFINE(pressureChan, pressureData_t, NULL, NULL, ZBUS_OBSERVERS_EMPTY,
+		 ZBUS_MSG_INIT(0));
+/* Decimated IMU samples (see imu_decimator.c) */
+ZBUS_CHAN_DEFINE(imuChan, motionData_t, NULL, NULL, ZBUS_OBSERVERS_EMPTY, ZBUS_MSG_INIT(0));
+
+/* Benchmark-only channel, so the bench never disturbs the real consumers */
+ZBUS_CHAN_DEFINE(benchChan, motionData_t, NULL, NULL, ZBUS_OBSERVERS_EMPTY, ZBUS_MSG_INIT(0));
+
+static uint32_t iBenchNotifications;
+
+static void benchListenerCallback(const struct zbus_channel *chan)
+{
+	iBenchNotifications++;
+}
+
+ZBUS_LISTENER_DEFINE(benchLis0, benchListenerCallback);
+ZBUS_LISTENER_DEFINE(benchLis1, benchListenerCallback);
+ZBUS_LISTENER_DEFINE(benchLis2, benchListenerCallback);
+ZBUS_LISTENER_DEFINE(benchLis3, benchListenerCallback);
+
+ZBUS_CHAN_ADD_OBS(benchChan, benchLis0, 0);
+ZBUS_CHAN_ADD_OBS(benchChan, benchLis1, 1);
+ZBUS_CHAN_ADD_OBS(benchChan, benchLis2, 2);
+ZBUS_CHAN_ADD_OBS(benchChan, benchLis3, 3);
+
+static const struct zbus_observer *const benchListeners[BENCH_OBSERVERS_MAX] = {
+	&benchLis0,
+	&benchLis1,
+	&benchLis2,
+	&benchLis3,
+};
+
+/*
+ * @brief benchRun - Publish iCount messages with iObservers listeners enabled.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @details
+ * Observers beyond iObservers are disabled with zbus_obs_set_enable(), so the channel's
+ * static observation list stays the same between runs.
+ *
+ * @syntax
+ * static int benchRun(const struct shell *sh, int iObservers, uint32_t iCount);
+ *
+ * @param[in] sh Shell used for the report.
+ * @param[in] iObservers Number of enabled listeners.
+ * @param[in] iCount Number of publishes.
+ *
+ * @return 0 on success, or a negative error code from zbus_chan_pub().
+ */
+static int benchRun(const struct shell *sh, int iObservers, uint32_t iCount)
+{
+	motionData_t sample = {0};
+	uint32_t iMin = UINT32_MAX;
+	uint32_t iMax = 0;
+	uint64_t iTotal = 0;
+
+	for (int iNum = 0; iNum < BENCH_OBSERVERS_MAX; iNum++) {
+		zbus_obs_set_enable((struct zbus_observer *)benchListeners[iNum], iNum < iObservers);
+	}
+
+	iBenchNotifications = 0;
+
+	for (uint32_t iNum = 0; iNum < iCount; iNum++) {
+		sample.accel.x = iNum;
+
+		uint32_t iStart = k_cycle_get_32();
+		int rc = zbus_chan_pub(&benchChan, &sample, BENCH_PUB_TIMEOUT);
+		uint32_t iCycles = k_cycle_get_32() - iStart;
+
+		if (rc != 0) {
+			shell_error(sh, "publish failed (%d)", rc);
+			return rc;
+		}
+
+		iTotal += iCycles;
+		iMin = MIN(iMin, iCycles);
+		iMax = MAX(iMax, iCycles);
+	}
+
+	shell_print(sh, "%d observer(s): avg %u ns, min %u ns, max %u ns (%u notifications)",
+		    iObservers, k_cyc_to_ns_floor32((uint32_t)(iTotal / iCount)),
+		    k_cyc_to_ns_floor32(iMin), k_cyc_to_ns_floor32(iMax), iBenchNotifications);
+	return 0;
+}
+
+static int shellZbusBench(const struct shell *sh, size_t argc, char **argv)
+{
+	static const int iObserverCounts[] = {1, 2, 4};
+	uint32_t iCount = BENCH_DEFAULT_PUBLISHES;
+
+	if (argc > 1) {
+		iCount = strtoul(argv[1], NULL, 10);
+		if (iCount == 0) {
+			shell_error(sh, "usage: sensor zbus bench [publishes]");
+			return -EINVAL;
+		}
+	}
+
+	shell_print(sh, "publishing %u x %u-byte messages", iCount, (uint32_t)sizeof(motionData_t));
+
+	for (int iNum = 0; iNum < ARRAY_SIZE(iObserverCounts); iNum++) {
+		int rc = benchRun(sh, iObserverCounts[iNum], iCount);
+
+		if (rc != 0) {
+			return rc;
+		}
+	}
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(subZbus,
+			       SHELL_CMD_ARG(bench, NULL,
+					     "Measure publish latency with 1, 2 and 4 listeners: "
+					     "bench [publishes]",
+					     shellZbusBench, 1, 1),
+			       SHELL_SUBCMD_SET_END);
+SHELL_SUBCMD_ADD((sensor), zbus, &subZbus, "Sensor data channels", NULL, 1, 0);
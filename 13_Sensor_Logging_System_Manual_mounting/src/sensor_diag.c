@@ -0,0 +1,122 @@
+/*
+ * @file sensor_diag.c
+ * @author Dhruv Mamtora
+ * @version 0.1.0
+ * @date  18 October, 2026
+ *
+ * @brief Runtime diagnostics for stack sizing and queue saturation.
+ *
+ * @details
+ * "sensor diag" collects, in one pass, what is needed to right-size RAM and spot a saturated
+ * pipeline in the field:
+ *
+ *   - per thread: stack high-water against its size, share of CPU time since boot and the
+ *     number of times it was scheduled in (context switches)
+ *   - per stream queue (stream_queue.c): current fill, peak fill, drops and overwrites
+ *
+ * Stack usage comes from the watermark left by CONFIG_INIT_STACKS, CPU share and switch
+ * counts from the scheduler's thread usage statistics. Threads above DIAG_STACK_WARN_PCT of
+ * their stack are flagged with '!'.
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+/** REQUIRED HEADER FILES */
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/sys/atomic.h>
+
+#include "sensor_structures.h"
+
+/** MACRO DEFINITIONS */
+/* Stack use above this share of the stack is flagged */
+#define DIAG_STACK_WARN_PCT 80
+
+/* Function prototypes */
+const streamQueue_t *streamQueueGet(int iIndex);
+
+/** LOGGING CONFIGURATION */
+/* Register the logging module for diagnostics. */
+LOG_MODULE_REGISTER(sensor_diag);
+
+/* Context handed to the per-thread callback */
+typedef struct {
+	const struct shell *sh;
+	uint64_t iTotalCycles;
+} diagContext_t;
+
+/*
+ * @brief diagThreadCallback - Print the diagnostics line of one thread.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @details
+ * Called by k_thread_foreach_unlocked(), so printing to the shell from here is allowed.
+ *
+ * @syntax
+ * static void diagThreadCallback(const struct k_thread *thread, void *pUserData);
+ *
+ * @param[in] thread Thread being reported.
+ * @param[in] pUserData diagContext_t of the current command.
+ *
+ * @return None.
+ */
+static void diagThreadCallback(const struct k_thread *thread, void *pUserData)
+{
+	diagContext_t *pContext = pUserData;
+	struct k_thread *pThread = (struct k_thread *)thread;
+	const char *cName = k_thread_name_get(pThread);
+	k_thread_runtime_stats_t stats;
+	size_t iStackSize = pThread->stack_info.size;
+	size_t iUnused = 0;
+	uint32_t iStackPct = 0;
+	uint32_t iCpuPermille = 0;
+
+	if (k_thread_stack_space_get(pThread, &iUnused) == 0 && iStackSize > 0) {
+		iStackPct = (uint32_t)(((iStackSize - iUnused) * 100) / iStackSize);
+	}
+
+	if (k_thread_runtime_stats_get(pThread, &stats) == 0 && pContext->iTotalCycles > 0) {
+		iCpuPermille = (uint32_t)((stats.execution_cycles * 1000) / pContext->iTotalCycles);
+	}
+
+	shell_print(pContext->sh, "%-24s %4d %5u/%-5u %3u%%%c %3u.%u%% %10u",
+		    (cName != NULL && cName[0] != '\0') ? cName : "?", pThread->base.prio,
+		    (uint32_t)(iStackSize - iUnused), (uint32_t)iStackSize, iStackPct,
+		    iStackPct > DIAG_STACK_WARN_PCT ? '!' : ' ', iCpuPermille / 10,
+		    iCpuPermille % 10, pThread->base.usage.num_windows);
+}
+
+static int shellDiag(const struct shell *sh, size_t argc, char **argv)
+{
+	k_thread_runtime_stats_t allStats;
+	diagContext_t context = {.sh = sh};
+	const streamQueue_t *pStream;
+
+	/* Includes idle time, so shares add up to 100 % of the time since boot */
+	if (k_thread_runtime_stats_all_get(&allStats) == 0) {
+		context.iTotalCycles = allStats.execution_cycles;
+	}
+
+	shell_print(sh, "%-24s %4s %11s %5s %6s %10s", "thread", "prio", "stack", "used", "cpu",
+		    "switches");
+	k_thread_foreach_unlocked(diagThreadCallback, &context);
+
+	shell_print(sh, "");
+	shell_print(sh, "%-20s %6s %6s %6s %9s %8s %11s", "queue", "fill", "peak", "depth",
+		    "accepted", "dropped", "overwritten");
+
+	for (int iNum = 0; (pStream = streamQueueGet(iNum)) != NULL; iNum++) {
+		shell_print(sh, "%-20s %6u %6ld %6u %9ld %8ld %11ld", pStream->cName,
+			    k_msgq_num_used_get(pStream->pQueue), atomic_get(&pStream->iPeak),
+			    pStream->pQueue->max_msgs, atomic_get(&pStream->iAccepted),
+			    atomic_get(&pStream->iDropped), atomic_get(&pStream->iOverwritten));
+	}
+
+	return 0;
+}
+
+SHELL_SUBCMD_ADD((sensor), diag, NULL, "Show thread stack, CPU and queue diagnostics", shellDiag,
+		 1, 0);
@@ -8,8 +8,10 @@
  *
  * @details
  * This file contains the implementation of the sensor logger thread, which is responsible for
- * receiving sensor data from various sensor threads and logging it. The logger thread uses a
- * message queue to receive data from the humidity sensor thread.
+ * receiving sensor data from various sensor threads and logging it. A zbus listener on the
+ * sensor channels copies each sample into a per-stream queue (stream_queue.c) whose overflow
+ * policy never lets a slow flash write delay the publishing sensor thread. The logger thread
+ * drains the queues and writes one record per decimated IMU sample.
  *
  * @copyright Copyright (c) 2025
  */
@@ -21,15 +23,26 @@
 #include <zephyr/fs/fs.h>
 #include <zephyr/fs/littlefs.h>
 #include <zephyr/storage/flash_map.h>
+#include <zephyr/zbus/zbus.h>
 
 #include "sensor_structures.h"
 
 /** MACRO DEFINITIONS */
 #define LOGGER_THREAD_STACK_SIZE 1024 * 4
 #define LOGGER_THREAD_PRIORITY   5
-#define LOGGER_THREAD_SLEEP_TIME K_SECONDS(30)
 
-#define QUEUE_TIMEOUT K_MSEC(1000)
+/* Environmental streams only need the latest value; decimated IMU samples are all kept
+ * unless flash falls more than IMU_STREAM_DEPTH records behind, then the oldest go first.
+ */
+#define ENV_STREAM_DEPTH 1
+#define IMU_STREAM_DEPTH 8
+
+/* The listener runs in the publishing sensor thread, so these streams never block it; the
+ * shell refuses the block policy for them (see stream_queue.c).
+ */
+#define LISTENER_STREAM_DEADLINE K_NO_WAIT
+
+#define IMU_EVENT_BATCH_MAX 32
 
 #define STORAGE_PARTITION_LABEL storage_partition
 #define MOUNT_POINT             "/lfs"
@@ -38,11 +51,77 @@
 /* Register the logging module for sensor logger operations. */
 LOG_MODULE_REGISTER(sensor_logger);
 
-/* Message queue to receive humidity data from the humidity sensor thread */
-extern struct k_msgq humMsgQ;
-extern struct k_msgq tempMsgQ;
-extern struct k_msgq pressureMsgQ;
-extern struct k_msgq imuMsgQ;
+/* Sensor channels, defined in sensor_channels.c */
+ZBUS_CHAN_DECLARE(humChan, tempChan, pressureChan, imuChan);
+
+/* Stream of IMU event records from the event thread */
+extern streamQueue_t imuEventStream;
+
+/* Function prototypes */
+int streamQueuePut(streamQueue_t *pStream, const void *pItem);
+void latencyRecord(latencyStage_t eStage, uint32_t iStartCycles);
+
+STREAM_QUEUE_DEFINE(humStream, humidityData_t, ENV_STREAM_DEPTH, STREAM_POLICY_COALESCE,
+		    LISTENER_STREAM_DEADLINE, NULL);
+STREAM_QUEUE_DEFINE(tempStream, temperatureData_t, ENV_STREAM_DEPTH, STREAM_POLICY_COALESCE,
+		    LISTENER_STREAM_DEADLINE, NULL);
+STREAM_QUEUE_DEFINE(pressureStream, pressureData_t, ENV_STREAM_DEPTH, STREAM_POLICY_COALESCE,
+		    LISTENER_STREAM_DEADLINE, NULL);
+STREAM_QUEUE_DEFINE(imuStream, motionData_t, IMU_STREAM_DEPTH, STREAM_POLICY_DROP_OLDEST,
+		    LISTENER_STREAM_DEADLINE, NULL);
+
+/* Given by the listener whenever a stream received an item */
+static K_SEM_DEFINE(loggerWakeSem, 0, 1);
+
+/* Cycle stamp of the IMU sample that last woke the logger, for the dequeue stage */
+static atomic_t iImuWakeCycles;
+
+/*
+ * @brief loggerListenerCallback - Forward a published sample to its stream queue.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @details
+ * Runs in the publishing sensor thread, so it only copies the sample under the stream's
+ * overflow policy and wakes the logger thread; all flash work happens in the logger thread.
+ *
+ * @syntax
+ * static void loggerListenerCallback(const struct zbus_channel *chan);
+ *
+ * @param[in] chan Channel that was published.
+ *
+ * @return None.
+ */
+static void loggerListenerCallback(const struct zbus_channel *chan)
+{
+	streamQueue_t *pStream;
+
+	if (chan == &humChan) {
+		pStream = &humStream;
+	} else if (chan == &tempChan) {
+		pStream = &tempStream;
+	} else if (chan == &pressureChan) {
+		pStream = &pressureStream;
+	} else if (chan == &imuChan) {
+		pStream = &imuStream;
+	} else {
+		return;
+	}
+
+	if (streamQueuePut(pStream, zbus_chan_const_msg(chan)) == 0) {
+		if (pStream == &imuStream) {
+			atomic_set(&iImuWakeCycles, (atomic_val_t)k_cycle_get_32());
+		}
+		k_sem_give(&loggerWakeSem);
+	}
+}
+
+ZBUS_LISTENER_DEFINE(loggerListener, loggerListenerCallback);
+ZBUS_CHAN_ADD_OBS(humChan, loggerListener, 3);
+ZBUS_CHAN_ADD_OBS(tempChan, loggerListener, 3);
+ZBUS_CHAN_ADD_OBS(pressureChan, loggerListener, 3);
+ZBUS_CHAN_ADD_OBS(imuChan, loggerListener, 3);
 
 FS_LITTLEFS_DECLARE_DEFAULT_CONFIG(cstorage);
 
@@ -112,13 +191,84 @@ int writeSensorData(sensorSharedBuffer_t *data)
 		return rc;
 	}
 
+	uint32_t iStartCycles = k_cycle_get_32();
+
 	rc = fs_write(&file, data, sizeof(sensorSharedBuffer_t));
 	if (rc < 0) {
 		LOG_ERR("Failed to write to data.bin (%d)", rc);
 	}
 
+	latencyRecord(LATENCY_STAGE_FS_WRITE, iStartCycles);
+	iStartCycles = k_cycle_get_32();
+
+	/* Sync while the file is still open; fs_sync() on a closed file only fails */
+	int iSyncRc = fs_sync(&file);
+	if (iSyncRc < 0) {
+		LOG_ERR("Failed to sync data.bin (%d)", iSyncRc);
+		rc = (rc < 0) ? rc : iSyncRc;
+	}
+
+	latencyRecord(LATENCY_STAGE_FS_SYNC, iStartCycles);
+	iStartCycles = k_cycle_get_32();
+
+	int iCloseRc = fs_close(&file);
+	if (iCloseRc < 0) {
+		LOG_ERR("Failed to close data.bin (%d)", iCloseRc);
+		rc = (rc < 0) ? rc : iCloseRc;
+	}
+
+	latencyRecord(LATENCY_STAGE_FS_CLOSE, iStartCycles);
+
+	return rc;
+}
+
+/*
+ * @brief writeImuEvents - Append all pending IMU event records to events.bin.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @details
+ * Drains the IMU event stream without blocking and writes the records with a single
+ * fs_write(). The file is only opened when at least one event is pending.
+ *
+ * @syntax
+ * int writeImuEvents(void);
+ *
+ * @return Number of records written, or a negative error code.
+ */
+int writeImuEvents(void)
+{
+	imuEvent_t events[IMU_EVENT_BATCH_MAX];
+	int iCount = 0;
+
+	while (iCount < ARRAY_SIZE(events) &&
+	       k_msgq_get(imuEventStream.pQueue, &events[iCount], K_NO_WAIT) == 0) {
+		iCount++;
+	}
+
+	if (iCount == 0) {
+		return 0;
+	}
+
+	struct fs_file_t file;
+	fs_file_t_init(&file);
+
+	int rc = fs_open(&file, "/lfs/events.bin", FS_O_CREATE | FS_O_WRITE | FS_O_APPEND);
+	if (rc < 0) {
+		LOG_ERR("Failed to open events.bin (%d)", rc);
+		return rc;
+	}
+
+	rc = fs_write(&file, events, iCount * sizeof(imuEvent_t));
+	if (rc < 0) {
+		LOG_ERR("Failed to write to events.bin (%d)", rc);
+	} else {
+		LOG_INF("Logged %d IMU event(s)", iCount);
+		rc = iCount;
+	}
+
 	fs_close(&file);
-	fs_sync(&file);
 
 	return rc;
 }
@@ -127,7 +277,7 @@ void printData(sensorSharedBuffer_t *data)
 {
 	LOG_INF("Humidity: %.2f %%", data->humidityData.dHumidity);
 	LOG_INF("Temperature: %.2f C", data->temperatureData.dTemperature);
-	LOG_INF("Pressure: %.2f hPa", data->pressureData.dPressure);
+	LOG_INF("Pressure: %.2f kPa", data->pressureData.dPressure);
 	LOG_INF("Accelerometer: X=%.2f Y=%.2f Z=%.2f", data->motionData.accel.x,
 		data->motionData.accel.y, data->motionData.accel.z);
 	LOG_INF("Gyroscope: X=%.2f Y=%.2f Z=%.2f", data->motionData.gyro.x, data->motionData.gyro.y,
@@ -141,10 +291,9 @@ void printData(sensorSharedBuffer_t *data)
  * @date 26 August, 2025
  *
  * @details
- * This thread continuously receives sensor data from the humidity sensor thread via a message
- * queue and logs the received data.
- *
- * @pre The humidity sensor thread must be running and sending data to the message queue.
+ * This thread waits for the listener's wakeup and drains the stream queues. Environmental
+ * samples update a local record; every decimated IMU sample completes the record, which is then
+ * printed and written to flash, followed by any pending IMU events.
  *
  * @syntax
  * void loggerThread(void *a, void *b, void *c);
@@ -158,20 +307,40 @@ void printData(sensorSharedBuffer_t *data)
 void loggerThread(void *a, void *b, void *c)
 {
 	loggerInit();
-	sensorSharedBuffer_t localBuffer;
+	sensorSharedBuffer_t localBuffer = {0};
 	LOG_INF("Logger thread started.");
 
 	while (1) {
-		k_msgq_get(&humMsgQ, &localBuffer.humidityData, QUEUE_TIMEOUT);
-		k_msgq_get(&tempMsgQ, &localBuffer.temperatureData, QUEUE_TIMEOUT);
-		k_msgq_get(&pressureMsgQ, &localBuffer.pressureData, QUEUE_TIMEOUT);
-		k_msgq_get(&imuMsgQ, &localBuffer.motionData, QUEUE_TIMEOUT);
+		k_sem_take(&loggerWakeSem, K_FOREVER);
+
+		while (k_msgq_get(humStream.pQueue, &localBuffer.humidityData, K_NO_WAIT) == 0) {
+		}
+		while (k_msgq_get(tempStream.pQueue, &localBuffer.temperatureData, K_NO_WAIT) ==
+		       0) {
+		}
+		while (k_msgq_get(pressureStream.pQueue, &localBuffer.pressureData, K_NO_WAIT) ==
+		       0) {
+		}
+
+		bool bFirst = true;
+
+		while (k_msgq_get(imuStream.pQueue, &localBuffer.motionData, K_NO_WAIT) == 0) {
+			if (bFirst) {
+				latencyRecord(LATENCY_STAGE_DEQUEUE,
+					      (uint32_t)atomic_get(&iImuWakeCycles));
+				bFirst = false;
+			}
+
+			uint32_t iStartCycles = k_cycle_get_32();
+
+			/* Log the received sensor data */
+			printData(&localBuffer);
 
-		/* Log the received sensor data */
-		printData(&localBuffer);
+			latencyRecord(LATENCY_STAGE_FORMAT, iStartCycles);
 
-		writeSensorData(&localBuffer);
-		k_sleep(LOGGER_THREAD_SLEEP_TIME);
+			writeSensorData(&localBuffer);
+			writeImuEvents();
+		}
 	}
 }
 
@@ -16,6 +16,11 @@
 #ifndef SENSOR_STRUCTURES_H
 #define SENSOR_STRUCTURES_H
 
+#include <stdint.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+
 typedef struct {
 	double dHumidity;
 } humidityData_t;
@@ -46,4 +51,119 @@ typedef struct {
 	motionData_t motionData;
 } sensorSharedBuffer_t;
 
+/* LSM6DSL embedded-function event types */
+typedef enum {
+	IMU_EVENT_FREE_FALL = 1,
+	IMU_EVENT_SINGLE_TAP,
+	IMU_EVENT_DOUBLE_TAP,
+	IMU_EVENT_TILT,
+} imuEventType_t;
+
+/* Compact record stored for every detected IMU event */
+typedef struct {
+	uint32_t iTimestampMs; /* Uptime when INT1 fired */
+	uint8_t iEventType;    /* imuEventType_t */
+	uint8_t iSource;       /* Raw source register for the event */
+	uint16_t iReserved;
+} imuEvent_t;
+
+/* Sources that can start an IMU capture */
+typedef enum {
+	CAPTURE_TRIGGER_THRESHOLD = 1,
+	CAPTURE_TRIGGER_SHELL,
+	CAPTURE_TRIGGER_BUTTON,
+} captureTrigger_t;
+
+/* Full-rate IMU sample held in the capture ring and stored in capture files */
+typedef struct {
+	uint32_t iTimestampMs;
+	float fAccel[3];
+	float fGyro[3];
+} captureSample_t;
+
+/* Header at the start of every capture file, followed by iSampleCount samples */
+typedef struct {
+	uint32_t iMagic;            /* CAPTURE_FILE_MAGIC */
+	uint32_t iTriggerTimestampMs;
+	uint16_t iOdrHz;
+	uint16_t iPreTriggerCount;  /* Samples recorded before the trigger */
+	uint16_t iSampleCount;      /* Total samples in the file */
+	uint8_t iTriggerSource;     /* captureTrigger_t */
+	uint8_t iReserved;
+} captureFileHeader_t;
+
+#define CAPTURE_FILE_MAGIC 0x31504143 /* "CAP1" */
+
+/* IMU calibration coefficients, persisted in storage1_partition */
+typedef struct {
+	uint32_t iVersion;
+	float fGyroBias[3];    /* rad/s, subtracted from the raw gyro */
+	float fAccelOffset[3]; /* m/s^2, subtracted before scaling */
+	float fAccelScale[3];
+} imuCalibData_t;
+
+#define IMU_CALIB_VERSION 1
+
+/* 250 ms of full-rate IMU data at 104 Hz */
+#define SAMPLE_BLOCK_SAMPLES 26
+
+/* Pool block shared by reference between IMU consumers (see sample_pool.c) */
+typedef struct {
+	atomic_t iRefCount;
+	uint32_t iSequence;
+	uint16_t iCount;
+	uint16_t iReserved;
+	captureSample_t samples[SAMPLE_BLOCK_SAMPLES];
+} sampleBlock_t;
+
+/* What a full stream queue does with a new item (see stream_queue.c) */
+typedef enum {
+	STREAM_POLICY_BLOCK,       /* Wait up to the stream deadline, then drop the new item */
+	STREAM_POLICY_DROP_NEWEST, /* Drop the new item */
+	STREAM_POLICY_DROP_OLDEST, /* Overwrite the oldest queued item */
+	STREAM_POLICY_COALESCE,    /* Keep only the latest item */
+	STREAM_POLICY_COUNT,
+} streamPolicy_t;
+
+/* Largest item a stream queue can carry; bounds the DROP_OLDEST scratch buffer */
+#define STREAM_QUEUE_ITEM_MAX 64
+
+/* Producer-to-consumer queue with an overflow policy and counters */
+typedef struct {
+	const char *cName;
+	struct k_msgq *pQueue;
+	k_timeout_t deadline;  /* STREAM_POLICY_BLOCK only; K_NO_WAIT: must never block */
+	atomic_t ePolicy;      /* streamPolicy_t */
+	atomic_t iAccepted;
+	atomic_t iDropped;     /* New items discarded */
+	atomic_t iOverwritten; /* Queued items discarded in favour of newer ones */
+	atomic_t iPeak;        /* Highest queue fill seen */
+	/* Called on every queued item the policy discards, NULL for plain values */
+	void (*pDiscard)(void *pItem);
+} streamQueue_t;
+
+#define STREAM_QUEUE_DEFINE(_name, _type, _depth, _policy, _deadline, _discard)                    \
+	BUILD_ASSERT(sizeof(_type) <= STREAM_QUEUE_ITEM_MAX);                                      \
+	K_MSGQ_DEFINE(_name##MsgQ, sizeof(_type), _depth, 4);                                      \
+	streamQueue_t _name = {                                                                    \
+		.cName = #_name,                                                                   \
+		.pQueue = &_name##MsgQ,                                                            \
+		.deadline = _deadline,                                                             \
+		.ePolicy = ATOMIC_INIT(_policy),                                                   \
+		.pDiscard = _discard,                                                              \
+	}
+
+/* Stage boundaries of the IMU-to-flash path timed by latency_profiler.c */
+typedef enum {
+	LATENCY_STAGE_FETCH,    /* sensor_sample_fetch() over I2C */
+	LATENCY_STAGE_CONVERT,  /* Channel read, float conversion and calibration */
+	LATENCY_STAGE_ENQUEUE,  /* zbus publish, including the logger listener's copy */
+	LATENCY_STAGE_DEQUEUE,  /* Listener wakeup until the logger thread runs */
+	LATENCY_STAGE_FORMAT,   /* Formatting the record for the log output */
+	LATENCY_STAGE_FS_WRITE, /* fs_write() of the record */
+	LATENCY_STAGE_FS_SYNC,  /* fs_sync() of the open file */
+	LATENCY_STAGE_FS_CLOSE, /* fs_close() */
+	LATENCY_STAGE_COUNT,
+} latencyStage_t;
+
 #endif /* SENSOR_STRUCTURES_H */
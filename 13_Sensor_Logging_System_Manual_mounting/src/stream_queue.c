@@ -0,0 +1,252 @@
+/*
+ * @file stream_queue.c
+ * @author Dhruv Mamtora
+ * @version 0.1.0
+ * @date  18 October, 2026
+ *
+ * @brief Overflow policies for producer-to-consumer queues.
+ *
+ * @details
+ * A streamQueue_t wraps a k_msgq with a policy that decides what happens when the consumer
+ * falls behind:
+ *
+ *   - block:       wait up to the stream deadline, then drop the new item
+ *   - drop_newest: drop the new item immediately, keeping the backlog
+ *   - drop_oldest: discard the oldest queued item to make room (ring-buffer overwrite)
+ *   - coalesce:    discard everything queued and keep only the new item
+ *
+ * Only "block" can delay the producer, and never longer than the stream deadline. Streams
+ * whose producer must never wait, such as those a zbus listener fills from the publishing
+ * thread, are defined with a K_NO_WAIT deadline: the shell refuses "block" for them. Every
+ * discarded item is counted as dropped (new item lost) or overwritten (queued item lost).
+ * Queued items that own something, such as the sampleBlock_t pointers of sample_pool.c, are
+ * passed to the stream's discard hook when a policy throws them away.
+ * "sensor stream" lists the streams and changes policies at runtime.
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+/** REQUIRED HEADER FILES */
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/sys/atomic.h>
+
+#include <stdio.h>
+#include <string.h>
+
+#include "sensor_structures.h"
+
+/* Function prototypes */
+int streamQueuePut(streamQueue_t *pStream, const void *pItem);
+const streamQueue_t *streamQueueGet(int iIndex);
+
+/** LOGGING CONFIGURATION */
+/* Register the logging module for stream queues. */
+LOG_MODULE_REGISTER(stream_queue);
+
+/* Streams, defined next to their consumer or producer */
+extern streamQueue_t humStream;
+extern streamQueue_t tempStream;
+extern streamQueue_t pressureStream;
+extern streamQueue_t imuStream;
+extern streamQueue_t imuEventStream;
+extern streamQueue_t imuAnalyticsStream;
+extern streamQueue_t imuRawLogStream;
+
+/** GLOBAL VARIABLES */
+static streamQueue_t *const streamQueues[] = {
+	&humStream,
+	&tempStream,
+	&pressureStream,
+	&imuStream,
+	&imuEventStream,
+	&imuAnalyticsStream,
+	&imuRawLogStream,
+};
+
+static const char *const cPolicyNames[STREAM_POLICY_COUNT] = {
+	[STREAM_POLICY_BLOCK] = "block",
+	[STREAM_POLICY_DROP_NEWEST] = "drop_newest",
+	[STREAM_POLICY_DROP_OLDEST] = "drop_oldest",
+	[STREAM_POLICY_COALESCE] = "coalesce",
+};
+
+/*
+ * @brief streamQueueDiscard - Account for a queued item the policy threw away.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @syntax
+ * static void streamQueueDiscard(streamQueue_t *pStream, void *pItem);
+ *
+ * @param[in] pStream Stream the item was taken from.
+ * @param[in] pItem Copy of the item.
+ *
+ * @return None.
+ */
+static void streamQueueDiscard(streamQueue_t *pStream, void *pItem)
+{
+	atomic_inc(&pStream->iOverwritten);
+
+	if (pStream->pDiscard != NULL) {
+		pStream->pDiscard(pItem);
+	}
+}
+
+/*
+ * @brief streamQueuePut - Queue one item according to the stream's overflow policy.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @details
+ * Each stream has a single producer, so the discard-then-put sequences below cannot be
+ * raced by another put; a concurrent get only makes more room.
+ *
+ * @syntax
+ * int streamQueuePut(streamQueue_t *pStream, const void *pItem);
+ *
+ * @param[in] pStream Stream to queue on.
+ * @param[in] pItem Item of the stream's message size.
+ *
+ * @return 0 when the new item was queued, -ENOMSG when it was dropped.
+ */
+int streamQueuePut(streamQueue_t *pStream, const void *pItem)
+{
+	uint8_t cScratch[STREAM_QUEUE_ITEM_MAX];
+	int rc;
+
+	switch ((streamPolicy_t)atomic_get(&pStream->ePolicy)) {
+	case STREAM_POLICY_BLOCK:
+		rc = k_msgq_put(pStream->pQueue, pItem, pStream->deadline);
+		break;
+
+	case STREAM_POLICY_DROP_OLDEST:
+		rc = k_msgq_put(pStream->pQueue, pItem, K_NO_WAIT);
+		if (rc != 0 && k_msgq_get(pStream->pQueue, cScratch, K_NO_WAIT) == 0) {
+			streamQueueDiscard(pStream, cScratch);
+			rc = k_msgq_put(pStream->pQueue, pItem, K_NO_WAIT);
+		}
+		break;
+
+	case STREAM_POLICY_COALESCE:
+		/* Items are taken out one by one (not purged) so each can be released */
+		while (k_msgq_get(pStream->pQueue, cScratch, K_NO_WAIT) == 0) {
+			streamQueueDiscard(pStream, cScratch);
+		}
+		rc = k_msgq_put(pStream->pQueue, pItem, K_NO_WAIT);
+		break;
+
+	case STREAM_POLICY_DROP_NEWEST:
+	default:
+		rc = k_msgq_put(pStream->pQueue, pItem, K_NO_WAIT);
+		break;
+	}
+
+	if (rc != 0) {
+		atomic_inc(&pStream->iDropped);
+		return -ENOMSG;
+	}
+
+	atomic_inc(&pStream->iAccepted);
+
+	atomic_val_t iUsed = k_msgq_num_used_get(pStream->pQueue);
+
+	if (iUsed > atomic_get(&pStream->iPeak)) {
+		atomic_set(&pStream->iPeak, iUsed);
+	}
+
+	return 0;
+}
+
+/*
+ * @brief streamQueueGet - Look up a stream by its index.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @details
+ * Lets other modules (sensor_diag.c) walk every stream without a copy of the list.
+ *
+ * @syntax
+ * const streamQueue_t *streamQueueGet(int iIndex);
+ *
+ * @param[in] iIndex Index from 0.
+ *
+ * @return Pointer to the stream, or NULL past the last one.
+ */
+const streamQueue_t *streamQueueGet(int iIndex)
+{
+	if (iIndex < 0 || iIndex >= ARRAY_SIZE(streamQueues)) {
+		return NULL;
+	}
+
+	return streamQueues[iIndex];
+}
+
+static int shellStreamList(const struct shell *sh)
+{
+	shell_print(sh, "%-20s %-12s %7s %9s %8s %11s", "stream", "policy", "fill", "accepted",
+		    "dropped", "overwritten");
+
+	for (int iNum = 0; iNum < ARRAY_SIZE(streamQueues); iNum++) {
+		streamQueue_t *pStream = streamQueues[iNum];
+		char cFill[12];
+
+		snprintf(cFill, sizeof(cFill), "%u/%u/%u", k_msgq_num_used_get(pStream->pQueue),
+			 (uint32_t)atomic_get(&pStream->iPeak), pStream->pQueue->max_msgs);
+		shell_print(sh, "%-20s %-12s %7s %9ld %8ld %11ld", pStream->cName,
+			    cPolicyNames[atomic_get(&pStream->ePolicy)], cFill,
+			    atomic_get(&pStream->iAccepted), atomic_get(&pStream->iDropped),
+			    atomic_get(&pStream->iOverwritten));
+	}
+
+	shell_print(sh, "fill = queued/peak/depth");
+	return 0;
+}
+
+static int shellStream(const struct shell *sh, size_t argc, char **argv)
+{
+	if (argc == 1) {
+		return shellStreamList(sh);
+	}
+
+	if (argc != 3) {
+		shell_error(sh, "usage: sensor stream [<name> <block|drop_newest|drop_oldest|coalesce>]");
+		return -EINVAL;
+	}
+
+	for (int iNum = 0; iNum < ARRAY_SIZE(streamQueues); iNum++) {
+		if (strcmp(argv[1], streamQueues[iNum]->cName) != 0) {
+			continue;
+		}
+
+		for (int iPolicy = 0; iPolicy < STREAM_POLICY_COUNT; iPolicy++) {
+			if (strcmp(argv[2], cPolicyNames[iPolicy]) != 0) {
+				continue;
+			}
+
+			if (iPolicy == STREAM_POLICY_BLOCK &&
+			    K_TIMEOUT_EQ(streamQueues[iNum]->deadline, K_NO_WAIT)) {
+				shell_error(sh, "%s must not block its producer", argv[1]);
+				return -EINVAL;
+			}
+
+			atomic_set(&streamQueues[iNum]->ePolicy, iPolicy);
+			shell_print(sh, "%s: %s", argv[1], argv[2]);
+			return 0;
+		}
+
+		shell_error(sh, "unknown policy: %s", argv[2]);
+		return -EINVAL;
+	}
+
+	shell_error(sh, "unknown stream: %s", argv[1]);
+	return -EINVAL;
+}
+
+SHELL_SUBCMD_ADD((sensor), stream, NULL,
+		 "Show stream queues or set a policy: stream [<name> <policy>]", shellStream, 1,
+		 2);
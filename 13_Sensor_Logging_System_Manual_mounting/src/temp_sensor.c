@@ -8,8 +8,8 @@
  *
  * @details
  * This file contains the implementation of the temperature sensor thread, which reads data from
- * the HTS221 sensor and sends the temperature data to the logger thread via a message queue
- * for logging.
+ * the HTS221 sensor and publishes the temperature data on tempChan for the logger and other
+ * observers.
  *
  * @copyright Copyright (c) 2025
  */
@@ -19,18 +19,16 @@
 #include <zephyr/drivers/sensor.h>
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
+#include <zephyr/zbus/zbus.h>
 
 #include "sensor_structures.h"
 
 /** MACRO DEFINITIONS */
-#define TEMP_SENSOR_THREAD_STACK_SIZE 512
+#define TEMP_SENSOR_THREAD_STACK_SIZE 1024
 #define TEMP_SENSOR_THREAD_PRIORITY   5
 #define TEMP_SENSOR_THREAD_SLEEP_TIME K_SECONDS(30)
 
-#define TEMP_Q_MAX_MSGS 10
-#define TEMP_Q_ALIGN    32
-
-#define TEMP_Q_TIMEOUT K_MSEC(1000)
+#define TEMP_PUB_TIMEOUT K_MSEC(100)
 
 /** DEVICE CONFIGURATION */
 /* Check if the HTS221 sensor is defined in the device tree. */
@@ -49,8 +47,8 @@ int tempSensorProcess(temperatureData_t *temperatureDataStruct);
 /* Register the logging module for humidity sensor operations. */
 LOG_MODULE_REGISTER(temp);
 
-/* Message queue to send humidity data to the logger thread */
-K_MSGQ_DEFINE(tempMsgQ, sizeof(temperatureData_t), TEMP_Q_MAX_MSGS, TEMP_Q_ALIGN);
+/* Channel for temperature samples, defined in sensor_channels.c */
+ZBUS_CHAN_DECLARE(tempChan);
 
 /*
  * @brief tempSensorProcess - Process temperature sensor data.
@@ -106,8 +104,8 @@ int tempSensorProcess(temperatureData_t *temperatureDataStruct)
  * @date 27 August, 2025
  *
  * @details
- * This thread continuously reads temperature data from the HTS221 sensor and sends it to the logger
- * thread via a message queue for logging.
+ * This thread continuously reads temperature data from the HTS221 sensor and publishes it on
+ * tempChan.
  *
  * @pre The sensor device must be initialized and ready.
  *
@@ -128,9 +126,9 @@ void tempSensorThread(void *a, void *b, void *c)
 
 	while (1) {
 		if (tempSensorProcess(&temperatureDataStruct) == 0) {
-			/* Send the temperature data to the logger thread */
-			if (k_msgq_put(&tempMsgQ, &temperatureDataStruct, TEMP_Q_TIMEOUT) != 0) {
-				LOG_WRN("Temperature message queue full, dropping data");
+			/* Publish once; zbus delivers to every observer */
+			if (zbus_chan_pub(&tempChan, &temperatureDataStruct, TEMP_PUB_TIMEOUT) != 0) {
+				LOG_WRN("Temperature publish failed, dropping data");
 			}
 		}
 		k_sleep(TEMP_SENSOR_THREAD_SLEEP_TIME);
@@ -0,0 +1,553 @@
+/*
+ * @file main.c
+ * @author Dhruv Mamtora
+ * @version 0.1.0
+ * @date 18 October, 2026
+ *
+ * @brief Cost of Zephyr synchronisation primitives in cycles per operation.
+ *
+ * @details
+ * Runs the two patterns of 11_Mutex_Synchronization and 12_Threads_Semaphore with every
+ * primitive that can implement them and prints one CSV row per run:
+ *
+ *   - counter:  BENCH_THREADS threads increment a shared counter BENCH_COUNTER_OPS times each,
+ *               protected by k_mutex, k_spinlock or k_sem, or lock-free with atomic_inc, an
+ *               atomic_cas loop or per-thread counters summed at the end. Each primitive runs
+ *               with one thread (uncontended cost) and with BENCH_THREADS threads.
+ *   - pingpong: two threads hand control back and forth BENCH_PINGPONG_ROUNDS times with
+ *               k_sem, k_condvar, k_msgq, or an atomic turn flag polled with k_yield().
+ *
+ * Columns: pattern, primitive, threads, ops, cycles, cycles_per_op, ns_per_op, ok. For the
+ * counter an op is one increment; for pingpong it is one handoff (half a round trip). ok is 1
+ * when the final counter or handoff count is exact.
+ *
+ * Build for hardware or QEMU, e.g. "west build -b qemu_cortex_m3" or "-b qemu_x86". On
+ * native_sim code runs in zero simulated time, so the rows show the correctness check but
+ * no meaningful cycle counts.
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+/** REQUIRED HEADER FILES */
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/printk.h>
+
+#include <string.h>
+
+/** MACRO DEFINITIONS */
+/* size of stack area used by each thread */
+#define BENCH_STACK_SIZE 1024
+/* scheduling priority used by each thread, lower than main so main can open the gate */
+#define BENCH_PRIORITY   5
+
+#define BENCH_THREADS         2
+#define BENCH_COUNTER_OPS     100000
+#define BENCH_PINGPONG_ROUNDS 10000
+
+/* Counter pattern: one loop of iOps increments by thread iThread */
+typedef struct {
+	const char *cName;
+	void (*pLoop)(int iThread, int iOps);
+} counterBench_t;
+
+/* Ping-pong pattern: player iPlayer (0 or 1) plays iRounds rounds */
+typedef struct {
+	const char *cName;
+	void (*pInit)(void);
+	void (*pPlay)(int iPlayer, int iRounds);
+} pingPongBench_t;
+
+/** GLOBAL VARIABLES */
+static volatile uint32_t iCounter;
+static atomic_t atomicCounter;
+static uint32_t iShardCounters[BENCH_THREADS];
+static volatile uint32_t iHandoffs;
+
+K_MUTEX_DEFINE(counterMutex);
+K_SEM_DEFINE(counterSem, 1, 1);
+static struct k_spinlock counterLock;
+
+K_SEM_DEFINE(pingSem, 0, 1);
+K_SEM_DEFINE(pongSem, 0, 1);
+K_MUTEX_DEFINE(turnMutex);
+K_CONDVAR_DEFINE(turnCondvar);
+K_MSGQ_DEFINE(pingMsgq, sizeof(uint32_t), 1, 4);
+K_MSGQ_DEFINE(pongMsgq, sizeof(uint32_t), 1, 4);
+static int iTurn;
+static atomic_t atomicTurn;
+
+/* Opened by main once per run so all threads start together */
+K_SEM_DEFINE(startGate, 0, BENCH_THREADS);
+
+K_THREAD_STACK_ARRAY_DEFINE(benchStacks, BENCH_THREADS, BENCH_STACK_SIZE);
+static struct k_thread benchThreads[BENCH_THREADS];
+
+/*
+ * @brief counterMutexLoop - Increment the counter under a k_mutex.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @param[in] iThread Index of the calling thread.
+ * @param[in] iOps Number of increments.
+ *
+ * @return None.
+ */
+static void counterMutexLoop(int iThread, int iOps)
+{
+	for (int iNum = 0; iNum < iOps; iNum++) {
+		k_mutex_lock(&counterMutex, K_FOREVER);
+		iCounter++;
+		k_mutex_unlock(&counterMutex);
+	}
+}
+
+/*
+ * @brief counterSpinlockLoop - Increment the counter under a k_spinlock.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @details
+ * On a single CPU the spinlock only masks interrupts, which is also what stops the time
+ * slice from preempting the critical section.
+ *
+ * @param[in] iThread Index of the calling thread.
+ * @param[in] iOps Number of increments.
+ *
+ * @return None.
+ */
+static void counterSpinlockLoop(int iThread, int iOps)
+{
+	for (int iNum = 0; iNum < iOps; iNum++) {
+		k_spinlock_key_t key = k_spin_lock(&counterLock);
+
+		iCounter++;
+		k_spin_unlock(&counterLock, key);
+	}
+}
+
+/*
+ * @brief counterSemLoop - Increment the counter under a binary k_sem.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @param[in] iThread Index of the calling thread.
+ * @param[in] iOps Number of increments.
+ *
+ * @return None.
+ */
+static void counterSemLoop(int iThread, int iOps)
+{
+	for (int iNum = 0; iNum < iOps; iNum++) {
+		k_sem_take(&counterSem, K_FOREVER);
+		iCounter++;
+		k_sem_give(&counterSem);
+	}
+}
+
+/*
+ * @brief counterAtomicLoop - Increment the counter with atomic_inc().
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @param[in] iThread Index of the calling thread.
+ * @param[in] iOps Number of increments.
+ *
+ * @return None.
+ */
+static void counterAtomicLoop(int iThread, int iOps)
+{
+	for (int iNum = 0; iNum < iOps; iNum++) {
+		atomic_inc(&atomicCounter);
+	}
+}
+
+/*
+ * @brief counterCasLoop - Increment the counter with a compare-and-swap retry loop.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @details
+ * The lock-free pattern used where the update is more than an add (e.g. a running maximum).
+ *
+ * @param[in] iThread Index of the calling thread.
+ * @param[in] iOps Number of increments.
+ *
+ * @return None.
+ */
+static void counterCasLoop(int iThread, int iOps)
+{
+	for (int iNum = 0; iNum < iOps; iNum++) {
+		atomic_val_t iOld;
+
+		do {
+			iOld = atomic_get(&atomicCounter);
+		} while (!atomic_cas(&atomicCounter, iOld, iOld + 1));
+	}
+}
+
+/*
+ * @brief counterShardedLoop - Increment a counter owned by the calling thread.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @details
+ * Nothing is shared while counting; the shards are summed after the threads have joined.
+ *
+ * @param[in] iThread Index of the calling thread.
+ * @param[in] iOps Number of increments.
+ *
+ * @return None.
+ */
+static void counterShardedLoop(int iThread, int iOps)
+{
+	volatile uint32_t *pShard = &iShardCounters[iThread];
+
+	for (int iNum = 0; iNum < iOps; iNum++) {
+		(*pShard)++;
+	}
+}
+
+static const counterBench_t counterBenches[] = {
+	{"mutex", counterMutexLoop},
+	{"spinlock", counterSpinlockLoop},
+	{"sem", counterSemLoop},
+	{"atomic", counterAtomicLoop},
+	{"cas", counterCasLoop},
+	{"sharded", counterShardedLoop},
+};
+
+/*
+ * @brief pingPongSemInit - Reset the semaphore pair.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @return None.
+ */
+static void pingPongSemInit(void)
+{
+	k_sem_reset(&pingSem);
+	k_sem_reset(&pongSem);
+	k_sem_give(&pingSem);
+}
+
+/*
+ * @brief pingPongSemPlay - Alternate with the other player through two semaphores.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @details
+ * Same structure as 12_Threads_Semaphore without the printk and sleep.
+ *
+ * @param[in] iPlayer 0 for ping, 1 for pong.
+ * @param[in] iRounds Number of rounds.
+ *
+ * @return None.
+ */
+static void pingPongSemPlay(int iPlayer, int iRounds)
+{
+	struct k_sem *pMine = (iPlayer == 0) ? &pingSem : &pongSem;
+	struct k_sem *pOther = (iPlayer == 0) ? &pongSem : &pingSem;
+
+	for (int iNum = 0; iNum < iRounds; iNum++) {
+		k_sem_take(pMine, K_FOREVER);
+		iHandoffs++;
+		k_sem_give(pOther);
+	}
+}
+
+/*
+ * @brief pingPongCondvarInit - Give the first turn to ping.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @return None.
+ */
+static void pingPongCondvarInit(void)
+{
+	iTurn = 0;
+}
+
+/*
+ * @brief pingPongCondvarPlay - Alternate on a turn variable guarded by a mutex and condvar.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @param[in] iPlayer 0 for ping, 1 for pong.
+ * @param[in] iRounds Number of rounds.
+ *
+ * @return None.
+ */
+static void pingPongCondvarPlay(int iPlayer, int iRounds)
+{
+	for (int iNum = 0; iNum < iRounds; iNum++) {
+		k_mutex_lock(&turnMutex, K_FOREVER);
+		while (iTurn != iPlayer) {
+			k_condvar_wait(&turnCondvar, &turnMutex, K_FOREVER);
+		}
+		iHandoffs++;
+		iTurn = !iPlayer;
+		k_condvar_signal(&turnCondvar);
+		k_mutex_unlock(&turnMutex);
+	}
+}
+
+/*
+ * @brief pingPongMsgqInit - Empty both queues and queue the first ball for ping.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @return None.
+ */
+static void pingPongMsgqInit(void)
+{
+	uint32_t iBall = 0;
+
+	k_msgq_purge(&pingMsgq);
+	k_msgq_purge(&pongMsgq);
+	k_msgq_put(&pingMsgq, &iBall, K_NO_WAIT);
+}
+
+/*
+ * @brief pingPongMsgqPlay - Pass a 4-byte ball through two one-slot message queues.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @param[in] iPlayer 0 for ping, 1 for pong.
+ * @param[in] iRounds Number of rounds.
+ *
+ * @return None.
+ */
+static void pingPongMsgqPlay(int iPlayer, int iRounds)
+{
+	struct k_msgq *pMine = (iPlayer == 0) ? &pingMsgq : &pongMsgq;
+	struct k_msgq *pOther = (iPlayer == 0) ? &pongMsgq : &pingMsgq;
+	uint32_t iBall;
+
+	for (int iNum = 0; iNum < iRounds; iNum++) {
+		k_msgq_get(pMine, &iBall, K_FOREVER);
+		iHandoffs++;
+		iBall++;
+		k_msgq_put(pOther, &iBall, K_FOREVER);
+	}
+}
+
+/*
+ * @brief pingPongAtomicInit - Give the first turn to ping.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @return None.
+ */
+static void pingPongAtomicInit(void)
+{
+	atomic_set(&atomicTurn, 0);
+}
+
+/*
+ * @brief pingPongAtomicPlay - Alternate on an atomic turn flag without kernel objects.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @details
+ * A waiting player yields instead of spinning so that the other player can run on a single
+ * CPU; on SMP the loop would normally spin instead.
+ *
+ * @param[in] iPlayer 0 for ping, 1 for pong.
+ * @param[in] iRounds Number of rounds.
+ *
+ * @return None.
+ */
+static void pingPongAtomicPlay(int iPlayer, int iRounds)
+{
+	for (int iNum = 0; iNum < iRounds; iNum++) {
+		while (atomic_get(&atomicTurn) != iPlayer) {
+			k_yield();
+		}
+		iHandoffs++;
+		atomic_set(&atomicTurn, !iPlayer);
+	}
+}
+
+static const pingPongBench_t pingPongBenches[] = {
+	{"sem", pingPongSemInit, pingPongSemPlay},
+	{"condvar", pingPongCondvarInit, pingPongCondvarPlay},
+	{"msgq", pingPongMsgqInit, pingPongMsgqPlay},
+	{"atomic_yield", pingPongAtomicInit, pingPongAtomicPlay},
+};
+
+/*
+ * @brief counterEntry - Thread entry for the counter pattern.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @param[in] a counterBench_t to run.
+ * @param[in] b Thread index.
+ * @param[in] c Unused.
+ *
+ * @return None.
+ */
+static void counterEntry(void *a, void *b, void *c)
+{
+	const counterBench_t *pBench = a;
+
+	k_sem_take(&startGate, K_FOREVER);
+	pBench->pLoop((int)(uintptr_t)b, BENCH_COUNTER_OPS);
+}
+
+/*
+ * @brief pingPongEntry - Thread entry for the ping-pong pattern.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @param[in] a pingPongBench_t to run.
+ * @param[in] b Player index.
+ * @param[in] c Unused.
+ *
+ * @return None.
+ */
+static void pingPongEntry(void *a, void *b, void *c)
+{
+	const pingPongBench_t *pBench = a;
+
+	k_sem_take(&startGate, K_FOREVER);
+	pBench->pPlay((int)(uintptr_t)b, BENCH_PINGPONG_ROUNDS);
+}
+
+/*
+ * @brief benchRun - Start iThreads threads together and time them until all have joined.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @details
+ * The threads block on startGate right after creation, because main runs at a higher
+ * priority. The clock starts when the gate opens and stops when the last thread has joined.
+ *
+ * @param[in] pEntry Thread entry.
+ * @param[in] pBench Benchmark descriptor passed as the first argument.
+ * @param[in] iThreads Number of threads.
+ *
+ * @return Elapsed hardware cycles.
+ */
+static uint32_t benchRun(k_thread_entry_t pEntry, const void *pBench, int iThreads)
+{
+	for (int iNum = 0; iNum < iThreads; iNum++) {
+		k_thread_create(&benchThreads[iNum], benchStacks[iNum], BENCH_STACK_SIZE, pEntry,
+				(void *)pBench, (void *)(uintptr_t)iNum, NULL, BENCH_PRIORITY, 0,
+				K_NO_WAIT);
+	}
+
+	uint32_t iStart = k_cycle_get_32();
+
+	for (int iNum = 0; iNum < iThreads; iNum++) {
+		k_sem_give(&startGate);
+	}
+
+	for (int iNum = 0; iNum < iThreads; iNum++) {
+		k_thread_join(&benchThreads[iNum], K_FOREVER);
+	}
+
+	return k_cycle_get_32() - iStart;
+}
+
+/*
+ * @brief benchPrintRow - Print one CSV row.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @details
+ * cycles_per_op is printed with two decimals from integer arithmetic, as printk has no
+ * floating point.
+ *
+ * @param[in] cPattern Pattern name.
+ * @param[in] cPrimitive Primitive name.
+ * @param[in] iThreads Number of threads.
+ * @param[in] iOps Operations in the run.
+ * @param[in] iCycles Elapsed hardware cycles.
+ * @param[in] bOk Whether the result was exact.
+ *
+ * @return None.
+ */
+static void benchPrintRow(const char *cPattern, const char *cPrimitive, int iThreads,
+			  uint32_t iOps, uint32_t iCycles, bool bOk)
+{
+	uint64_t iCentiCycles = ((uint64_t)iCycles * 100) / iOps;
+	uint64_t iNsPerOp = k_cyc_to_ns_floor64(iCycles) / iOps;
+
+	printk("%s,%s,%d,%u,%u,%u.%02u,%u,%d\n", cPattern, cPrimitive, iThreads, iOps, iCycles,
+	       (uint32_t)(iCentiCycles / 100), (uint32_t)(iCentiCycles % 100), (uint32_t)iNsPerOp,
+	       bOk);
+}
+
+/*
+ * @brief main - Run every benchmark and print the results as CSV.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @return 0.
+ *
+ * @retval 0 Success
+ */
+int main(void)
+{
+	printk("# sync benchmark on %s, %u cycles/s\n", CONFIG_BOARD,
+	       sys_clock_hw_cycles_per_sec());
+	printk("pattern,primitive,threads,ops,cycles,cycles_per_op,ns_per_op,ok\n");
+
+	for (int iBench = 0; iBench < ARRAY_SIZE(counterBenches); iBench++) {
+		const counterBench_t *pBench = &counterBenches[iBench];
+
+		for (int iThreads = 1; iThreads <= BENCH_THREADS; iThreads++) {
+			uint32_t iOps = (uint32_t)iThreads * BENCH_COUNTER_OPS;
+			uint32_t iTotal = 0;
+
+			iCounter = 0;
+			atomic_clear(&atomicCounter);
+			memset(iShardCounters, 0, sizeof(iShardCounters));
+
+			uint32_t iCycles = benchRun(counterEntry, pBench, iThreads);
+
+			iTotal = iCounter + (uint32_t)atomic_get(&atomicCounter);
+			for (int iNum = 0; iNum < BENCH_THREADS; iNum++) {
+				iTotal += iShardCounters[iNum];
+			}
+
+			benchPrintRow("counter", pBench->cName, iThreads, iOps, iCycles,
+				      iTotal == iOps);
+		}
+	}
+
+	for (int iBench = 0; iBench < ARRAY_SIZE(pingPongBenches); iBench++) {
+		const pingPongBench_t *pBench = &pingPongBenches[iBench];
+		uint32_t iOps = 2 * BENCH_PINGPONG_ROUNDS;
+
+		iHandoffs = 0;
+		pBench->pInit();
+
+		uint32_t iCycles = benchRun(pingPongEntry, pBench, 2);
+
+		benchPrintRow("pingpong", pBench->cName, 2, iOps, iCycles, iHandoffs == iOps);
+	}
+
+	printk("# done\n");
+	return 0;
+}
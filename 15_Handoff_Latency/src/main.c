@@ -0,0 +1,418 @@
+/*
+ * @file main.c
+ * @author Dhruv Mamtora
+ * @version 0.1.0
+ * @date 18 October, 2026
+ *
+ * @brief Semaphore handoff latency and jitter.
+ *
+ * @details
+ * Turns the semaphore demos of 10_Thread_Semaphore (one thread signals another) and
+ * 12_Threads_Semaphore (two threads ping-pong) into a latency harness. The giving side takes a
+ * k_cycle_get_32() stamp right before k_sem_give() and the taking side a stamp right after
+ * k_sem_take() returns; the difference is one handoff. There are no sleeps, so the cases run
+ * back to back:
+ *
+ *   - same_prio:  ping-pong between two threads of equal priority; the giver has to block on
+ *                 its own semaphore before the other thread runs (12_Threads_Semaphore)
+ *   - cross_prio: a low-priority thread signals a high-priority one, which preempts it at once
+ *                 (10_Thread_Semaphore)
+ *   - isr:        a k_timer expiry function (interrupt context) signals a high-priority thread
+ *                 every tick; the stamp is taken inside the ISR, so interrupt entry is not
+ *                 included
+ *
+ * Each case fills a histogram of LAT_BUCKETS buckets LAT_BUCKET_CYCLES wide; longer handoffs
+ * are counted as overflow and still update the maximum. The results are printed as CSV with
+ * min, median, 99th percentile and max in cycles and nanoseconds, followed by a compressed
+ * histogram of each case. Assumes a single CPU, as on the DISCO-L475-IOT1.
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+/** REQUIRED HEADER FILES */
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+
+#include <string.h>
+
+/** MACRO DEFINITIONS */
+#define LAT_STACK_SIZE 1024
+/* Both below main so that main only runs again once a case has finished */
+#define LAT_PRIO_HIGH  2
+#define LAT_PRIO_LOW   7
+
+/* Handoffs per thread case and per ISR case (one ISR handoff per tick) */
+#define LAT_ROUNDS      1000000
+#define LAT_ISR_SAMPLES 10000
+
+/* 1024 buckets of 4 cycles cover 4096 cycles, about 51 us at 80 MHz */
+#define LAT_BUCKETS       1024
+#define LAT_BUCKET_CYCLES 4
+
+/* Rows of the printed histogram */
+#define LAT_PRINT_ROWS 16
+#define LAT_BAR_WIDTH  50
+
+typedef struct {
+	const char *cName;
+	uint32_t iCount;
+	uint32_t iMin;
+	uint32_t iMax;
+	uint32_t iOverflow;
+	uint32_t iBuckets[LAT_BUCKETS];
+} latencyHist_t;
+
+/** GLOBAL VARIABLES */
+static latencyHist_t sameHist = {.cName = "same_prio"};
+static latencyHist_t crossHist = {.cName = "cross_prio"};
+static latencyHist_t isrHist = {.cName = "isr"};
+
+/* Stamp taken by the giver right before k_sem_give() */
+static volatile uint32_t iGiveStamp;
+
+K_SEM_DEFINE(pingSem, 0, 1);
+K_SEM_DEFINE(pongSem, 0, 1);
+K_SEM_DEFINE(signalSem, 0, 1);
+
+static struct k_timer isrTimer;
+static volatile uint32_t iIsrGiven;
+
+K_THREAD_STACK_DEFINE(stackA, LAT_STACK_SIZE);
+K_THREAD_STACK_DEFINE(stackB, LAT_STACK_SIZE);
+static struct k_thread threadA;
+static struct k_thread threadB;
+
+/*
+ * @brief latencyRecord - Add one handoff to a histogram.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @details
+ * Called only by the thread that just took the semaphore, so no locking is needed on a single
+ * CPU.
+ *
+ * @param[in] pHist Histogram of the running case.
+ * @param[in] iStart Stamp taken by the giver.
+ *
+ * @return None.
+ */
+static void latencyRecord(latencyHist_t *pHist, uint32_t iStart)
+{
+	uint32_t iCycles = k_cycle_get_32() - iStart;
+	uint32_t iBucket = iCycles / LAT_BUCKET_CYCLES;
+
+	if (iBucket < LAT_BUCKETS) {
+		pHist->iBuckets[iBucket]++;
+	} else {
+		pHist->iOverflow++;
+	}
+
+	pHist->iMin = MIN(pHist->iMin, iCycles);
+	pHist->iMax = MAX(pHist->iMax, iCycles);
+	pHist->iCount++;
+}
+
+/*
+ * @brief latencyPercentile - Upper edge of the bucket holding a percentile.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @param[in] pHist Histogram to read.
+ * @param[in] iPercent Percentile (1..100).
+ *
+ * @return Cycles, accurate to LAT_BUCKET_CYCLES, or UINT32_MAX when it lies in the overflow.
+ */
+static uint32_t latencyPercentile(const latencyHist_t *pHist, uint32_t iPercent)
+{
+	uint64_t iTarget = ((uint64_t)pHist->iCount * iPercent + 99) / 100;
+	uint64_t iSeen = 0;
+
+	for (int iBucket = 0; iBucket < LAT_BUCKETS; iBucket++) {
+		iSeen += pHist->iBuckets[iBucket];
+		if (iSeen >= iTarget) {
+			return (iBucket + 1) * LAT_BUCKET_CYCLES;
+		}
+	}
+
+	return UINT32_MAX;
+}
+
+/*
+ * @brief pingEntry - Same-priority ping thread.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @details
+ * Stamps and gives pongSem, then blocks on pingSem, which is what lets the pong thread run.
+ * Records the pong-to-ping handoff when it gets pingSem back.
+ *
+ * @return None.
+ */
+static void pingEntry(void *a, void *b, void *c)
+{
+	for (int iNum = 0; iNum < LAT_ROUNDS / 2; iNum++) {
+		iGiveStamp = k_cycle_get_32();
+		k_sem_give(&pongSem);
+		k_sem_take(&pingSem, K_FOREVER);
+		latencyRecord(&sameHist, iGiveStamp);
+	}
+}
+
+/*
+ * @brief pongEntry - Same-priority pong thread.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @return None.
+ */
+static void pongEntry(void *a, void *b, void *c)
+{
+	for (int iNum = 0; iNum < LAT_ROUNDS / 2; iNum++) {
+		k_sem_take(&pongSem, K_FOREVER);
+		latencyRecord(&sameHist, iGiveStamp);
+		iGiveStamp = k_cycle_get_32();
+		k_sem_give(&pingSem);
+	}
+}
+
+/*
+ * @brief waiterEntry - High-priority thread that records every handoff to it.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @param[in] a latencyHist_t to fill.
+ * @param[in] b Number of handoffs to wait for.
+ * @param[in] c Unused.
+ *
+ * @return None.
+ */
+static void waiterEntry(void *a, void *b, void *c)
+{
+	latencyHist_t *pHist = a;
+	uint32_t iSamples = (uint32_t)(uintptr_t)b;
+
+	for (uint32_t iNum = 0; iNum < iSamples; iNum++) {
+		k_sem_take(&signalSem, K_FOREVER);
+		latencyRecord(pHist, iGiveStamp);
+	}
+}
+
+/*
+ * @brief signallerEntry - Low-priority thread that signals the waiter.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @details
+ * The waiter preempts inside k_sem_give(), records, and blocks again before this thread
+ * continues, so the next give always finds it waiting.
+ *
+ * @return None.
+ */
+static void signallerEntry(void *a, void *b, void *c)
+{
+	for (int iNum = 0; iNum < LAT_ROUNDS; iNum++) {
+		iGiveStamp = k_cycle_get_32();
+		k_sem_give(&signalSem);
+	}
+}
+
+/*
+ * @brief isrTimerExpiry - Signal the waiter from interrupt context.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @param[in] timer Expired timer.
+ *
+ * @return None.
+ */
+static void isrTimerExpiry(struct k_timer *timer)
+{
+	if (iIsrGiven >= LAT_ISR_SAMPLES) {
+		k_timer_stop(timer);
+		return;
+	}
+
+	iIsrGiven++;
+	iGiveStamp = k_cycle_get_32();
+	k_sem_give(&signalSem);
+}
+
+/*
+ * @brief latencyPrintRow - Print the CSV row of one case.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @param[in] pHist Histogram of the case.
+ *
+ * @return None.
+ */
+static void latencyPrintRow(const latencyHist_t *pHist)
+{
+	uint32_t iValues[4] = {
+		pHist->iMin,
+		latencyPercentile(pHist, 50),
+		latencyPercentile(pHist, 99),
+		pHist->iMax,
+	};
+
+	/* A percentile in the overflow is only known to be above the range; print the max */
+	for (int iNum = 1; iNum < 3; iNum++) {
+		iValues[iNum] = MIN(iValues[iNum], pHist->iMax);
+	}
+
+	printk("%s,%u,%u", pHist->cName, pHist->iCount, pHist->iOverflow);
+	for (int iNum = 0; iNum < 4; iNum++) {
+		printk(",%u", iValues[iNum]);
+	}
+	for (int iNum = 0; iNum < 4; iNum++) {
+		printk(",%u", (uint32_t)k_cyc_to_ns_floor64(iValues[iNum]));
+	}
+	printk("\n");
+}
+
+/*
+ * @brief latencyPrintHistogram - Print a case's histogram in LAT_PRINT_ROWS rows.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @details
+ * The rows span the populated range of buckets, from the minimum to the maximum (or the end
+ * of the range), so the shape of the jitter is visible whatever the absolute latency is.
+ *
+ * @param[in] pHist Histogram of the case.
+ *
+ * @return None.
+ */
+static void latencyPrintHistogram(const latencyHist_t *pHist)
+{
+	uint32_t iRows[LAT_PRINT_ROWS] = {0};
+	uint32_t iFirst = pHist->iMin / LAT_BUCKET_CYCLES;
+	uint32_t iLast = MIN(pHist->iMax / LAT_BUCKET_CYCLES, LAT_BUCKETS - 1);
+	uint32_t iPerRow;
+	uint32_t iPeak = 0;
+	char cBar[LAT_BAR_WIDTH + 1];
+
+	if (pHist->iCount == 0 || iFirst >= LAT_BUCKETS) {
+		printk("# %s: no samples in range\n", pHist->cName);
+		return;
+	}
+
+	iPerRow = (iLast - iFirst) / LAT_PRINT_ROWS + 1;
+
+	for (uint32_t iBucket = iFirst; iBucket <= iLast; iBucket++) {
+		iRows[(iBucket - iFirst) / iPerRow] += pHist->iBuckets[iBucket];
+	}
+	for (int iRow = 0; iRow < LAT_PRINT_ROWS; iRow++) {
+		iPeak = MAX(iPeak, iRows[iRow]);
+	}
+
+	printk("# %s histogram (cycles)\n", pHist->cName);
+	for (int iRow = 0; iRow < LAT_PRINT_ROWS; iRow++) {
+		uint32_t iFrom = (iFirst + iRow * iPerRow) * LAT_BUCKET_CYCLES;
+		uint32_t iWidth;
+
+		if (iFrom > iLast * LAT_BUCKET_CYCLES) {
+			break;
+		}
+
+		iWidth = (uint32_t)(((uint64_t)iRows[iRow] * LAT_BAR_WIDTH + iPeak - 1) / iPeak);
+		memset(cBar, '#', iWidth);
+		cBar[iWidth] = '\0';
+		printk("# %6u+ %9u %s\n", iFrom, iRows[iRow], cBar);
+	}
+	if (pHist->iOverflow > 0) {
+		printk("# %6u+ %9u (overflow)\n", LAT_BUCKETS * LAT_BUCKET_CYCLES, pHist->iOverflow);
+	}
+}
+
+/*
+ * @brief latencyReset - Clear a histogram before its case runs.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @param[in] pHist Histogram to clear.
+ *
+ * @return None.
+ */
+static void latencyReset(latencyHist_t *pHist)
+{
+	pHist->iCount = 0;
+	pHist->iOverflow = 0;
+	pHist->iMin = UINT32_MAX;
+	pHist->iMax = 0;
+	memset(pHist->iBuckets, 0, sizeof(pHist->iBuckets));
+}
+
+/*
+ * @brief main - Run the three cases and print the results.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @details
+ * Each case creates its threads and joins them. The waiter of the ISR case is started first
+ * so that it is blocked on signalSem before the timer fires.
+ *
+ * @return 0.
+ *
+ * @retval 0 Success
+ */
+int main(void)
+{
+	printk("# handoff latency on %s, %u cycles/s\n", CONFIG_BOARD,
+	       sys_clock_hw_cycles_per_sec());
+
+	/* same_prio: ping-pong between equal priorities */
+	latencyReset(&sameHist);
+	k_sem_reset(&pingSem);
+	k_sem_reset(&pongSem);
+	k_thread_create(&threadA, stackA, LAT_STACK_SIZE, pongEntry, NULL, NULL, NULL,
+			LAT_PRIO_LOW, 0, K_NO_WAIT);
+	k_thread_create(&threadB, stackB, LAT_STACK_SIZE, pingEntry, NULL, NULL, NULL,
+			LAT_PRIO_LOW, 0, K_NO_WAIT);
+	k_thread_join(&threadA, K_FOREVER);
+	k_thread_join(&threadB, K_FOREVER);
+
+	/* cross_prio: low-priority signaller, high-priority waiter */
+	latencyReset(&crossHist);
+	k_sem_reset(&signalSem);
+	k_thread_create(&threadA, stackA, LAT_STACK_SIZE, waiterEntry, &crossHist,
+			(void *)(uintptr_t)LAT_ROUNDS, NULL, LAT_PRIO_HIGH, 0, K_NO_WAIT);
+	k_thread_create(&threadB, stackB, LAT_STACK_SIZE, signallerEntry, NULL, NULL, NULL,
+			LAT_PRIO_LOW, 0, K_NO_WAIT);
+	k_thread_join(&threadA, K_FOREVER);
+	k_thread_join(&threadB, K_FOREVER);
+
+	/* isr: timer interrupt to high-priority waiter, one handoff per tick */
+	latencyReset(&isrHist);
+	k_sem_reset(&signalSem);
+	iIsrGiven = 0;
+	k_thread_create(&threadA, stackA, LAT_STACK_SIZE, waiterEntry, &isrHist,
+			(void *)(uintptr_t)LAT_ISR_SAMPLES, NULL, LAT_PRIO_HIGH, 0, K_NO_WAIT);
+	k_timer_init(&isrTimer, isrTimerExpiry, NULL);
+	k_timer_start(&isrTimer, K_TICKS(1), K_TICKS(1));
+	k_thread_join(&threadA, K_FOREVER);
+	k_timer_stop(&isrTimer);
+
+	printk("case,samples,overflow,min_cyc,p50_cyc,p99_cyc,max_cyc,min_ns,p50_ns,p99_ns,"
+	       "max_ns\n");
+	latencyPrintRow(&sameHist);
+	latencyPrintRow(&crossHist);
+	latencyPrintRow(&isrHist);
+
+	latencyPrintHistogram(&sameHist);
+	latencyPrintHistogram(&crossHist);
+	latencyPrintHistogram(&isrHist);
+
+	return 0;
+}
@@ -0,0 +1,41 @@
+/*
+ * @file bench_uart.h
+ * @author Dhruv Mamtora
+ * @version 0.1.0
+ * @date 18 October, 2026
+ *
+ * @brief Byte stream over the UART under test, one implementation per UART API.
+ *
+ * @details
+ * bench_uart_poll.c, bench_uart_irq.c and bench_uart_async.c implement the same calls; the
+ * Kconfig choice UART_BENCH_MODE selects which one is built. Reads return whatever has arrived
+ * and writes block until everything is queued, so no data is lost in either direction and the
+ * benchmark measures the API rather than buffer sizing.
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+#ifndef BENCH_UART_H
+#define BENCH_UART_H
+
+/** REQUIRED HEADER FILES */
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+
+/** MACRO DEFINITIONS */
+#if defined(CONFIG_UART_BENCH_MODE_POLL)
+#define BENCH_UART_MODE "poll"
+#elif defined(CONFIG_UART_BENCH_MODE_IRQ)
+#define BENCH_UART_MODE "irq"
+#else
+#define BENCH_UART_MODE "async"
+#endif
+
+/* Function prototypes */
+int benchUartInit(const struct device *pDev);
+size_t benchUartRead(uint8_t *pBuf, size_t iMax, k_timeout_t timeout);
+void benchUartWrite(const uint8_t *pData, size_t iLen);
+int benchUartFlush(k_timeout_t timeout);
+uint32_t benchUartDropped(void);
+
+#endif /* BENCH_UART_H */
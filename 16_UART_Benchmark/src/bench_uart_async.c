@@ -0,0 +1,257 @@
+/*
+ * @file bench_uart_async.c
+ * @author Dhruv Mamtora
+ * @version 0.1.0
+ * @date 18 October, 2026
+ *
+ * @brief Asynchronous-API implementation of bench_uart.h.
+ *
+ * @details
+ * Same structure as 08_UART_Interrupt and 09_UART_Interrupt_Control_LED: the driver receives
+ * into BENCH_RX_BUF_COUNT rotating buffers (by DMA where it supports it) and reports data
+ * after BENCH_RX_TIMEOUT_US of line idle; transmission is one uart_tx() at a time of a region
+ * claimed from txRing, as in uart_tx.c. Unlike uart_tx.c, benchUartWrite() waits for room
+ * instead of dropping, so a full buffer shows up as time rather than as lost bytes.
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+/** REQUIRED HEADER FILES */
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/uart.h>
+#include <zephyr/sys/ring_buffer.h>
+
+#include "bench_uart.h"
+
+/** MACRO DEFINITIONS */
+#define BENCH_RX_BUF_SIZE   256
+/* One being filled, one queued in the driver and one spare while RX_BUF_RELEASED is pending */
+#define BENCH_RX_BUF_COUNT  3
+#define BENCH_RX_TIMEOUT_US 100
+
+/** GLOBAL VARIABLES */
+RING_BUF_DECLARE(rxRing, CONFIG_UART_BENCH_RING_SIZE);
+RING_BUF_DECLARE(txRing, CONFIG_UART_BENCH_RING_SIZE);
+
+K_SEM_DEFINE(rxSem, 0, 1);
+K_SEM_DEFINE(txSem, 0, 1);
+
+static const struct device *benchDev;
+static struct k_spinlock benchLock;
+static uint8_t rxBufs[BENCH_RX_BUF_COUNT][BENCH_RX_BUF_SIZE];
+static int iNextRxBuf;
+static bool bTxBusy;
+static uint32_t iTxClaimed;
+static uint32_t iRxDropped;
+
+/*
+ * @brief startTx - Send the next contiguous region of txRing.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @pre benchLock must be held.
+ *
+ * @return None.
+ */
+static void startTx(void)
+{
+	uint8_t *pData;
+
+	if (bTxBusy) {
+		return;
+	}
+
+	iTxClaimed = ring_buf_get_claim(&txRing, &pData, CONFIG_UART_BENCH_RING_SIZE);
+	if (iTxClaimed == 0) {
+		return;
+	}
+
+	bTxBusy = true;
+	if (uart_tx(benchDev, pData, iTxClaimed, SYS_FOREVER_US) < 0) {
+		/* the driver will not report this region; drop it so the buffer cannot stall */
+		ring_buf_get_finish(&txRing, iTxClaimed);
+		iTxClaimed = 0;
+		bTxBusy = false;
+		k_sem_give(&txSem);
+	}
+}
+
+/*
+ * @brief benchUartCallback - Asynchronous UART event callback.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @details
+ * Runs in interrupt context. Received data is copied into rxRing right away so the buffer can
+ * be handed back to the driver; RX is restarted if the driver disables it after an error.
+ *
+ * @param[in] dev Pointer to UART device structure.
+ * @param[in] evt UART event.
+ * @param[in] user_data Pointer to user data (not used here).
+ *
+ * @return None.
+ */
+static void benchUartCallback(const struct device *dev, struct uart_event *evt, void *user_data)
+{
+	k_spinlock_key_t key;
+	uint32_t iPut;
+
+	switch (evt->type) {
+	case UART_TX_DONE:
+	case UART_TX_ABORTED:
+		key = k_spin_lock(&benchLock);
+		ring_buf_get_finish(&txRing, iTxClaimed);
+		iTxClaimed = 0;
+		bTxBusy = false;
+		startTx();
+		k_spin_unlock(&benchLock, key);
+		k_sem_give(&txSem);
+		break;
+
+	case UART_RX_RDY:
+		key = k_spin_lock(&benchLock);
+		iPut = ring_buf_put(&rxRing, &evt->data.rx.buf[evt->data.rx.offset],
+				    evt->data.rx.len);
+		iRxDropped += evt->data.rx.len - iPut;
+		k_spin_unlock(&benchLock, key);
+		k_sem_give(&rxSem);
+		break;
+
+	case UART_RX_BUF_REQUEST:
+		uart_rx_buf_rsp(dev, rxBufs[iNextRxBuf], BENCH_RX_BUF_SIZE);
+		iNextRxBuf = (iNextRxBuf + 1) % BENCH_RX_BUF_COUNT;
+		break;
+
+	case UART_RX_DISABLED:
+		uart_rx_enable(dev, rxBufs[iNextRxBuf], BENCH_RX_BUF_SIZE, BENCH_RX_TIMEOUT_US);
+		iNextRxBuf = (iNextRxBuf + 1) % BENCH_RX_BUF_COUNT;
+		break;
+
+	default:
+		break;
+	}
+}
+
+/*
+ * @brief benchUartInit - Register the callback and start receiving.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @param[in] pDev UART device.
+ *
+ * @return 0 on success, or the error of uart_callback_set() or uart_rx_enable().
+ */
+int benchUartInit(const struct device *pDev)
+{
+	int iReturn;
+
+	benchDev = pDev;
+
+	iReturn = uart_callback_set(benchDev, benchUartCallback, NULL);
+	if (iReturn < 0) {
+		return iReturn;
+	}
+
+	iNextRxBuf = 1;
+	return uart_rx_enable(benchDev, rxBufs[0], BENCH_RX_BUF_SIZE, BENCH_RX_TIMEOUT_US);
+}
+
+/*
+ * @brief benchUartRead - Read the bytes that have arrived.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @param[out] pBuf Destination.
+ * @param[in] iMax Size of pBuf.
+ * @param[in] timeout Maximum time to wait for the first byte.
+ *
+ * @return Number of bytes read, 0 on timeout.
+ */
+size_t benchUartRead(uint8_t *pBuf, size_t iMax, k_timeout_t timeout)
+{
+	k_timepoint_t deadline = sys_timepoint_calc(timeout);
+	k_spinlock_key_t key;
+	uint32_t iCount;
+
+	while (true) {
+		key = k_spin_lock(&benchLock);
+		iCount = ring_buf_get(&rxRing, pBuf, iMax);
+		k_spin_unlock(&benchLock, key);
+
+		/* a stale give only costs one more pass */
+		if (iCount > 0 || k_sem_take(&rxSem, sys_timepoint_timeout(deadline)) != 0) {
+			return iCount;
+		}
+	}
+}
+
+/*
+ * @brief benchUartWrite - Queue bytes, waiting for room when txRing is full.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @param[in] pData Data to send.
+ * @param[in] iLen Number of bytes.
+ *
+ * @return None.
+ */
+void benchUartWrite(const uint8_t *pData, size_t iLen)
+{
+	k_spinlock_key_t key;
+	uint32_t iPut;
+
+	while (iLen > 0) {
+		key = k_spin_lock(&benchLock);
+		iPut = ring_buf_put(&txRing, pData, iLen);
+		startTx();
+		k_spin_unlock(&benchLock, key);
+
+		pData += iPut;
+		iLen -= iPut;
+		if (iLen > 0) {
+			k_sem_take(&txSem, K_FOREVER);
+		}
+	}
+}
+
+/*
+ * @brief benchUartFlush - Wait until every queued byte has been sent.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @param[in] timeout Maximum time to wait.
+ *
+ * @return 0 when the transmitter is idle, -EAGAIN on timeout.
+ */
+int benchUartFlush(k_timeout_t timeout)
+{
+	k_timepoint_t deadline = sys_timepoint_calc(timeout);
+
+	while (bTxBusy || !ring_buf_is_empty(&txRing)) {
+		if (k_sem_take(&txSem, sys_timepoint_timeout(deadline)) != 0) {
+			return -EAGAIN;
+		}
+	}
+
+	return 0;
+}
+
+/*
+ * @brief benchUartDropped - Received bytes lost to a full rxRing.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @return Count since start-up.
+ */
+uint32_t benchUartDropped(void)
+{
+	return iRxDropped;
+}
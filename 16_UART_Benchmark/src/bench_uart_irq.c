@@ -0,0 +1,222 @@
+/*
+ * @file bench_uart_irq.c
+ * @author Dhruv Mamtora
+ * @version 0.1.0
+ * @date 18 October, 2026
+ *
+ * @brief Interrupt-driven implementation of bench_uart.h.
+ *
+ * @details
+ * The UART interrupt empties the RX FIFO into rxRing and refills the TX FIFO from txRing, so
+ * the CPU only runs when the FIFOs need service. Threads block on a semaphore instead of
+ * polling: rxSem is given when data arrives and txSem when the transmitter has taken data.
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+/** REQUIRED HEADER FILES */
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/uart.h>
+#include <zephyr/sys/ring_buffer.h>
+
+#include "bench_uart.h"
+
+/** GLOBAL VARIABLES */
+RING_BUF_DECLARE(rxRing, CONFIG_UART_BENCH_RING_SIZE);
+RING_BUF_DECLARE(txRing, CONFIG_UART_BENCH_RING_SIZE);
+
+K_SEM_DEFINE(rxSem, 0, 1);
+K_SEM_DEFINE(txSem, 0, 1);
+
+static const struct device *benchDev;
+static struct k_spinlock benchLock;
+static uint32_t iRxDropped;
+
+/*
+ * @brief benchUartIsr - Service the RX and TX FIFOs.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @details
+ * The RX FIFO is always emptied, even when rxRing is full, or the interrupt would fire again
+ * at once; those bytes are counted in iRxDropped. The TX interrupt is disabled when txRing
+ * runs empty and enabled again by benchUartWrite().
+ *
+ * @param[in] dev Pointer to UART device structure.
+ * @param[in] user_data Pointer to user data (not used here).
+ *
+ * @return None.
+ */
+static void benchUartIsr(const struct device *dev, void *user_data)
+{
+	k_spinlock_key_t key;
+	uint8_t *pData;
+	uint32_t iLen;
+	int iCount;
+
+	if (!uart_irq_update(dev)) {
+		return;
+	}
+
+	if (uart_irq_rx_ready(dev)) {
+		key = k_spin_lock(&benchLock);
+		do {
+			iLen = ring_buf_put_claim(&rxRing, &pData, CONFIG_UART_BENCH_RING_SIZE);
+			if (iLen == 0) {
+				uint8_t cDiscard;
+
+				iCount = uart_fifo_read(dev, &cDiscard, 1);
+				iRxDropped += MAX(iCount, 0);
+			} else {
+				iCount = uart_fifo_read(dev, pData, iLen);
+				ring_buf_put_finish(&rxRing, MAX(iCount, 0));
+			}
+		} while (iCount > 0);
+		k_spin_unlock(&benchLock, key);
+
+		k_sem_give(&rxSem);
+	}
+
+	if (uart_irq_tx_ready(dev)) {
+		key = k_spin_lock(&benchLock);
+		iLen = ring_buf_get_claim(&txRing, &pData, CONFIG_UART_BENCH_RING_SIZE);
+		if (iLen == 0) {
+			uart_irq_tx_disable(dev);
+		} else {
+			iCount = uart_fifo_fill(dev, pData, iLen);
+			ring_buf_get_finish(&txRing, MAX(iCount, 0));
+		}
+		k_spin_unlock(&benchLock, key);
+
+		k_sem_give(&txSem);
+	}
+}
+
+/*
+ * @brief benchUartInit - Register the interrupt handler and start receiving.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @param[in] pDev UART device.
+ *
+ * @return 0 on success, or the error of uart_irq_callback_user_data_set().
+ */
+int benchUartInit(const struct device *pDev)
+{
+	int iReturn;
+
+	benchDev = pDev;
+
+	iReturn = uart_irq_callback_user_data_set(benchDev, benchUartIsr, NULL);
+	if (iReturn < 0) {
+		return iReturn;
+	}
+
+	uart_irq_rx_enable(benchDev);
+	return 0;
+}
+
+/*
+ * @brief benchUartRead - Read the bytes that have arrived.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @param[out] pBuf Destination.
+ * @param[in] iMax Size of pBuf.
+ * @param[in] timeout Maximum time to wait for the first byte.
+ *
+ * @return Number of bytes read, 0 on timeout.
+ */
+size_t benchUartRead(uint8_t *pBuf, size_t iMax, k_timeout_t timeout)
+{
+	k_timepoint_t deadline = sys_timepoint_calc(timeout);
+	k_spinlock_key_t key;
+	uint32_t iCount;
+
+	while (true) {
+		key = k_spin_lock(&benchLock);
+		iCount = ring_buf_get(&rxRing, pBuf, iMax);
+		k_spin_unlock(&benchLock, key);
+
+		/* a stale give only costs one more pass */
+		if (iCount > 0 || k_sem_take(&rxSem, sys_timepoint_timeout(deadline)) != 0) {
+			return iCount;
+		}
+	}
+}
+
+/*
+ * @brief benchUartWrite - Queue bytes, waiting for room when txRing is full.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @param[in] pData Data to send.
+ * @param[in] iLen Number of bytes.
+ *
+ * @return None.
+ */
+void benchUartWrite(const uint8_t *pData, size_t iLen)
+{
+	k_spinlock_key_t key;
+	uint32_t iPut;
+
+	while (iLen > 0) {
+		key = k_spin_lock(&benchLock);
+		iPut = ring_buf_put(&txRing, pData, iLen);
+		k_spin_unlock(&benchLock, key);
+
+		if (iPut > 0) {
+			uart_irq_tx_enable(benchDev);
+		}
+
+		pData += iPut;
+		iLen -= iPut;
+		if (iLen > 0) {
+			k_sem_take(&txSem, K_FOREVER);
+		}
+	}
+}
+
+/*
+ * @brief benchUartFlush - Wait until txRing is empty.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @details
+ * The last FIFO load may still be on the line when this returns.
+ *
+ * @param[in] timeout Maximum time to wait.
+ *
+ * @return 0 when everything has been handed to the UART, -EAGAIN on timeout.
+ */
+int benchUartFlush(k_timeout_t timeout)
+{
+	k_timepoint_t deadline = sys_timepoint_calc(timeout);
+
+	while (!ring_buf_is_empty(&txRing)) {
+		if (k_sem_take(&txSem, sys_timepoint_timeout(deadline)) != 0) {
+			return -EAGAIN;
+		}
+	}
+
+	return 0;
+}
+
+/*
+ * @brief benchUartDropped - Received bytes lost to a full rxRing.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @return Count since start-up.
+ */
+uint32_t benchUartDropped(void)
+{
+	return iRxDropped;
+}
@@ -0,0 +1,132 @@
+/*
+ * @file bench_uart_poll.c
+ * @author Dhruv Mamtora
+ * @version 0.1.0
+ * @date 18 October, 2026
+ *
+ * @brief Polling implementation of bench_uart.h.
+ *
+ * @details
+ * The CPU spins on the UART status register in both directions, so the busy cycles of this
+ * mode are the whole time spent waiting for the line. Between empty polls the loop calls
+ * k_busy_wait(BENCH_POLL_IDLE_US): on hardware that is still spinning, while on native_sim it
+ * is what lets simulated time, and with it the read timeout, advance.
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+/** REQUIRED HEADER FILES */
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/uart.h>
+
+#include "bench_uart.h"
+
+/** MACRO DEFINITIONS */
+#define BENCH_POLL_IDLE_US 1
+
+/** GLOBAL VARIABLES */
+static const struct device *benchDev;
+
+/*
+ * @brief benchUartInit - Select the UART under test.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @param[in] pDev UART device.
+ *
+ * @return 0.
+ */
+int benchUartInit(const struct device *pDev)
+{
+	benchDev = pDev;
+	return 0;
+}
+
+/*
+ * @brief benchUartRead - Read the bytes that have arrived.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @details
+ * Polls until at least one byte is available or the timeout expires, then drains the receiver
+ * without waiting any further.
+ *
+ * @param[out] pBuf Destination.
+ * @param[in] iMax Size of pBuf.
+ * @param[in] timeout Maximum time to wait for the first byte.
+ *
+ * @return Number of bytes read, 0 on timeout.
+ */
+size_t benchUartRead(uint8_t *pBuf, size_t iMax, k_timeout_t timeout)
+{
+	k_timepoint_t deadline = sys_timepoint_calc(timeout);
+	size_t iCount = 0;
+
+	while (true) {
+		while (iCount < iMax && uart_poll_in(benchDev, &pBuf[iCount]) == 0) {
+			iCount++;
+		}
+
+		if (iCount > 0 || sys_timepoint_expired(deadline)) {
+			return iCount;
+		}
+		k_busy_wait(BENCH_POLL_IDLE_US);
+	}
+}
+
+/*
+ * @brief benchUartWrite - Send bytes, waiting for each to enter the transmitter.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @param[in] pData Data to send.
+ * @param[in] iLen Number of bytes.
+ *
+ * @return None.
+ */
+void benchUartWrite(const uint8_t *pData, size_t iLen)
+{
+	for (size_t i = 0; i < iLen; i++) {
+		uart_poll_out(benchDev, pData[i]);
+	}
+}
+
+/*
+ * @brief benchUartFlush - Wait until everything written has been sent.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @details
+ * uart_poll_out() returns once the byte is in the transmitter, so there is nothing to wait
+ * for.
+ *
+ * @param[in] timeout Unused.
+ *
+ * @return 0.
+ */
+int benchUartFlush(k_timeout_t timeout)
+{
+	return 0;
+}
+
+/*
+ * @brief benchUartDropped - Received bytes lost to a full buffer.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @details
+ * There is no software buffer; bytes that arrive while the CPU is not polling are lost in the
+ * UART itself and only show up as a short count on the host.
+ *
+ * @return 0.
+ */
+uint32_t benchUartDropped(void)
+{
+	return 0;
+}
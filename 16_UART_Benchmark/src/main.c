@@ -0,0 +1,313 @@
+/*
+ * @file main.c
+ * @author Dhruv Mamtora
+ * @version 0.1.0
+ * @date 18 October, 2026
+ *
+ * @brief UART throughput, latency and CPU cost for the polling, interrupt and async APIs.
+ *
+ * @details
+ * Serves tests requested by tools/uart_bench.py over the UART aliased as bench-uart, using the
+ * API chosen by CONFIG_UART_BENCH_MODE (see bench_uart.h). The host sends one command line and
+ * waits for "READY" before sending any data, so commands and data never mix:
+ *
+ *   INFO            -> "INFO mode=<mode> board=<board> cyc_per_sec=<n>"
+ *   ECHO <bytes>    -> "READY", then every byte received is sent back until <bytes> have
+ *                      been echoed; the host times round trips of small messages
+ *   RX <bytes>      -> "READY", then <bytes> are received and discarded
+ *   TX <bytes>      -> "READY", then <bytes> of the pattern 0, 1, ... 255, 0, 1 ... are sent
+ *
+ * ECHO, RX and TX end with "DONE bytes=<n> us=<n> busy_cyc=<n> dropped=<n>". us runs from
+ * the first byte to the last, busy_cyc is the number of non-idle CPU cycles (threads and
+ * interrupts, from the thread runtime statistics) over the same span and dropped is the number
+ * of received bytes the software buffer had no room for. If no byte arrives for
+ * BENCH_IDLE_TIMEOUT_MS the test stops with "ERR timeout bytes=<n>".
+ *
+ * On native_sim code runs in zero simulated time, so busy_cyc is meaningless there and the
+ * host tool measures the CPU time of the zephyr.exe process instead; the throughput and
+ * latency are those of the pseudo terminal and the emulated UART, which makes the modes
+ * comparable with each other but not with a real line. Build for the board for absolute
+ * numbers.
+ *
+ * @copyright Copyright (c) 2026
+ */
+
+/** REQUIRED HEADER FILES */
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/sys/printk.h>
+
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench_uart.h"
+
+/** MACRO DEFINITIONS */
+#define BENCH_UART_NODE DT_ALIAS(bench_uart)
+
+#define BENCH_CHUNK_SIZE      256
+#define BENCH_LINE_SIZE       64
+#define BENCH_IDLE_TIMEOUT_MS 2000
+
+#if !DT_NODE_EXISTS(BENCH_UART_NODE)
+#error "Add a bench-uart alias for this board, see boards/"
+#endif
+
+/** GLOBAL VARIABLES */
+static const struct device *const benchDev = DEVICE_DT_GET(BENCH_UART_NODE);
+
+static uint8_t chunkBuf[BENCH_CHUNK_SIZE];
+
+/* Start of the running test */
+static int64_t iStartTicks;
+static uint64_t iStartBusy;
+static uint32_t iStartDropped;
+
+/*
+ * @brief busyCycles - Non-idle cycles since start-up.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @return Cycles spent outside the idle thread, including interrupts.
+ */
+static uint64_t busyCycles(void)
+{
+	k_thread_runtime_stats_t stats;
+
+	if (k_thread_runtime_stats_all_get(&stats) != 0) {
+		return 0;
+	}
+
+	return stats.total_cycles;
+}
+
+/*
+ * @brief benchReply - Send a formatted reply line through the UART under test.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @param[in] cFmt printk-style format, without the line ending.
+ *
+ * @return None.
+ */
+static void benchReply(const char *cFmt, ...)
+{
+	char cReplyBuf[96];
+	va_list args;
+	int iLen;
+
+	va_start(args, cFmt);
+	iLen = vsnprintk(cReplyBuf, sizeof(cReplyBuf) - 1, cFmt, args);
+	va_end(args);
+
+	iLen = MIN(iLen, (int)sizeof(cReplyBuf) - 2);
+	cReplyBuf[iLen++] = '\n';
+	benchUartWrite((const uint8_t *)cReplyBuf, iLen);
+	benchUartFlush(K_MSEC(BENCH_IDLE_TIMEOUT_MS));
+}
+
+/*
+ * @brief benchStart - Take the start stamps of a test.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @details
+ * Called when the first data byte has arrived (ECHO, RX) or is about to be sent (TX), so the
+ * time the host needs to react to "READY" is not counted.
+ *
+ * @return None.
+ */
+static void benchStart(void)
+{
+	iStartTicks = k_uptime_ticks();
+	iStartBusy = busyCycles();
+	iStartDropped = benchUartDropped();
+}
+
+/*
+ * @brief benchDone - Report the result of a test.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @param[in] iBytes Bytes transferred.
+ *
+ * @return None.
+ */
+static void benchDone(uint32_t iBytes)
+{
+	uint64_t iBusy = busyCycles() - iStartBusy;
+	uint64_t iMicros = k_ticks_to_us_floor64(k_uptime_ticks() - iStartTicks);
+
+	benchReply("DONE bytes=%u us=%llu busy_cyc=%llu dropped=%u", iBytes,
+		   (unsigned long long)iMicros, (unsigned long long)iBusy,
+		   benchUartDropped() - iStartDropped);
+}
+
+/*
+ * @brief benchReceive - Receive a test's bytes, echoing them if asked to.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @param[in] iBytes Bytes to receive.
+ * @param[in] bEcho Send every byte back.
+ *
+ * @return None.
+ */
+static void benchReceive(uint32_t iBytes, bool bEcho)
+{
+	uint32_t iDone = 0;
+	size_t iCount;
+
+	benchReply("READY");
+
+	while (iDone < iBytes) {
+		iCount = benchUartRead(chunkBuf, MIN(iBytes - iDone, BENCH_CHUNK_SIZE),
+				       K_MSEC(BENCH_IDLE_TIMEOUT_MS));
+		if (iCount == 0) {
+			benchReply("ERR timeout bytes=%u", iDone);
+			return;
+		}
+
+		if (iDone == 0) {
+			benchStart();
+		}
+		if (bEcho) {
+			benchUartWrite(chunkBuf, iCount);
+		}
+		iDone += iCount;
+	}
+
+	benchUartFlush(K_MSEC(BENCH_IDLE_TIMEOUT_MS));
+	benchDone(iDone);
+}
+
+/*
+ * @brief benchTransmit - Send a test's bytes as fast as the API allows.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @param[in] iBytes Bytes to send.
+ *
+ * @return None.
+ */
+static void benchTransmit(uint32_t iBytes)
+{
+	uint32_t iDone = 0;
+	size_t iCount;
+
+	for (int i = 0; i < BENCH_CHUNK_SIZE; i++) {
+		chunkBuf[i] = i;
+	}
+
+	benchReply("READY");
+	benchStart();
+
+	while (iDone < iBytes) {
+		iCount = MIN(iBytes - iDone, BENCH_CHUNK_SIZE);
+		benchUartWrite(chunkBuf, iCount);
+		iDone += iCount;
+	}
+
+	if (benchUartFlush(K_MSEC(BENCH_IDLE_TIMEOUT_MS)) < 0) {
+		benchReply("ERR timeout bytes=%u", iDone);
+		return;
+	}
+	benchDone(iDone);
+}
+
+/*
+ * @brief readCommand - Read one command line.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @details
+ * Reads a byte at a time so that nothing after the line ending is consumed. Carriage returns
+ * are ignored and overlong lines are cut to the buffer size.
+ *
+ * @param[out] cLine Buffer for the NUL-terminated line.
+ * @param[in] iSize Size of cLine.
+ *
+ * @return None.
+ */
+static void readCommand(char *cLine, size_t iSize)
+{
+	size_t iLen = 0;
+	uint8_t cByte;
+
+	while (true) {
+		if (benchUartRead(&cByte, 1, K_FOREVER) == 0) {
+			continue;
+		}
+		if (cByte == '\n') {
+			break;
+		}
+		if (cByte != '\r' && iLen < iSize - 1) {
+			cLine[iLen++] = cByte;
+		}
+	}
+
+	cLine[iLen] = '\0';
+}
+
+/*
+ * @brief main - Serve benchmark commands on the UART under test.
+ *
+ * @author Dhruv Mamtora
+ * @date 18 October, 2026
+ *
+ * @pre bench-uart alias must be defined in the device tree.
+ *
+ * @return Return -1 on Error; does not return otherwise.
+ *
+ * @retval -1 UART not ready or the API is not supported by its driver
+ */
+int main(void)
+{
+	char cLine[BENCH_LINE_SIZE];
+	uint32_t iBytes;
+	int iReturn;
+
+	if (!device_is_ready(benchDev)) {
+		printk("Benchmark UART %s not ready\n", benchDev->name);
+		return -1;
+	}
+
+	iReturn = benchUartInit(benchDev);
+	if (iReturn < 0) {
+		printk("Cannot use %s in %s mode: %d\n", benchDev->name, BENCH_UART_MODE, iReturn);
+		return -1;
+	}
+
+	printk("# uart benchmark on %s, mode %s, device %s\n", CONFIG_BOARD, BENCH_UART_MODE,
+	       benchDev->name);
+
+	while (true) {
+		readCommand(cLine, sizeof(cLine));
+
+		if (strcmp(cLine, "INFO") == 0) {
+			benchReply("INFO mode=%s board=%s cyc_per_sec=%u", BENCH_UART_MODE,
+				   CONFIG_BOARD, sys_clock_hw_cycles_per_sec());
+		} else if (strncmp(cLine, "ECHO ", 5) == 0) {
+			iBytes = strtoul(&cLine[5], NULL, 10);
+			benchReceive(iBytes, true);
+		} else if (strncmp(cLine, "RX ", 3) == 0) {
+			iBytes = strtoul(&cLine[3], NULL, 10);
+			benchReceive(iBytes, false);
+		} else if (strncmp(cLine, "TX ", 3) == 0) {
+			iBytes = strtoul(&cLine[3], NULL, 10);
+			benchTransmit(iBytes);
+		} else if (cLine[0] != '\0') {
+			benchReply("ERR unknown command");
+		}
+	}
+
+	return 0;
+}
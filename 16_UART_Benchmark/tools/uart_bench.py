@@ -0,0 +1,289 @@
+#!/usr/bin/env python3
+"""Drive the UART benchmark firmware (see src/main.c) and print the results as CSV.
+
+Starts one or more native_sim builds and talks to each through its pseudo terminal, or talks
+to a board through a serial port (needs pyserial). Every target runs an echo latency test, an
+RX and a TX throughput test; on native_sim the CPU time of the zephyr.exe process is measured
+per test as well.
+
+    uart_bench.py --exe build_poll/zephyr/zephyr.exe --exe build_irq/zephyr/zephyr.exe
+    uart_bench.py --port /dev/ttyACM0 --baud 115200 --bytes 32768
+"""
+
+import argparse
+import os
+import queue
+import re
+import select
+import subprocess
+import sys
+import threading
+import time
+import tty
+
+PTY_LINE = re.compile(r"(\S+) connected to pseudotty: (\S+)")
+COLUMNS = (
+    "mode,test,bytes,seconds,kib_per_s,p50_us,p90_us,p99_us,max_us,"
+    "dev_cyc_per_byte,host_cpu_ns_per_byte,lost"
+)
+# The firmware gives up on a test after this long without data (BENCH_IDLE_TIMEOUT_MS)
+DEVICE_IDLE_TIMEOUT = 2.0
+
+
+class PtyLink:
+    """Raw pseudo terminal with a read timeout."""
+
+    def __init__(self, path):
+        self.fd = os.open(path, os.O_RDWR | os.O_NOCTTY)
+        tty.setraw(self.fd)
+
+    def write(self, data):
+        view = memoryview(data)
+        while view:
+            view = view[os.write(self.fd, view) :]
+
+    def read(self, size, timeout):
+        ready, _, _ = select.select([self.fd], [], [], timeout)
+        return os.read(self.fd, size) if ready else b""
+
+    def close(self):
+        os.close(self.fd)
+
+
+class SerialLink:
+    """pyserial port with the same interface as PtyLink."""
+
+    def __init__(self, port, baud):
+        try:
+            import serial
+        except ImportError:
+            sys.exit("pyserial is needed to use a serial port: pip install pyserial")
+        self.port = serial.Serial(port, baud, timeout=0)
+
+    def write(self, data):
+        self.port.write(data)
+
+    def read(self, size, timeout):
+        self.port.timeout = timeout
+        return self.port.read(max(1, min(size, self.port.in_waiting)))
+
+    def close(self):
+        self.port.close()
+
+
+class Target:
+    """Firmware under test, plus the zephyr.exe process when it runs on native_sim."""
+
+    def __init__(self, link, process=None):
+        self.link = link
+        self.process = process
+        self.pending = bytearray()
+
+    @classmethod
+    def spawn(cls, exe, uart_name):
+        process = subprocess.Popen(
+            [exe], stdout=subprocess.PIPE, stderr=subprocess.STDOUT, text=True
+        )
+        lines = queue.Queue()
+        threading.Thread(target=cls._pump, args=(process.stdout, lines), daemon=True).start()
+
+        path, started = None, False
+        deadline = time.monotonic() + 10
+        while path is None or not started:
+            try:
+                line = lines.get(timeout=max(deadline - time.monotonic(), 0.01))
+            except queue.Empty:
+                process.kill()
+                sys.exit(f"{exe}: no pseudo terminal for {uart_name} or no banner")
+            match = PTY_LINE.search(line)
+            if match and match.group(1) == uart_name:
+                path = match.group(2)
+            started = started or line.startswith("# uart benchmark")
+        return cls(PtyLink(path), process)
+
+    @staticmethod
+    def _pump(stream, lines):
+        # Keep reading the console so the process never blocks on a full pipe
+        for line in stream:
+            lines.put(line)
+
+    def cpu_ns(self):
+        """CPU time of the zephyr.exe process so far, None for a board."""
+        if self.process is None:
+            return None
+        with open(f"/proc/{self.process.pid}/schedstat") as stat:
+            return int(stat.read().split()[0])
+
+    def read_exact(self, size, timeout=5.0):
+        while len(self.pending) < size:
+            data = self.link.read(max(size - len(self.pending), 4096), timeout)
+            if not data:
+                raise TimeoutError(f"got {len(self.pending)} of {size} bytes")
+            self.pending += data
+        data = bytes(self.pending[:size])
+        del self.pending[:size]
+        return data
+
+    def read_line(self, timeout=5.0):
+        while b"\n" not in self.pending:
+            data = self.link.read(4096, timeout)
+            if not data:
+                raise TimeoutError("no reply line")
+            self.pending += data
+        end = self.pending.index(b"\n")
+        line = self.pending[:end].decode(errors="replace").strip()
+        del self.pending[: end + 1]
+        return line
+
+    def command(self, line, expect):
+        self.link.write(line.encode() + b"\n")
+        reply = self.read_line()
+        if not reply.startswith(expect):
+            raise RuntimeError(f"{line!r}: unexpected reply {reply!r}")
+        return reply
+
+    def done(self):
+        """Counters of the DONE line; after "ERR timeout" only bytes is known."""
+        reply = self.read_line(timeout=30.0)
+        if not reply.startswith(("DONE", "ERR timeout")):
+            raise RuntimeError(f"test failed: {reply}")
+        fields = dict(f.split("=") for f in reply.split() if "=" in f)
+        return {k: int(fields.get(k, 0)) for k in ("bytes", "us", "busy_cyc", "dropped")}
+
+    def resync(self):
+        """Wait for the firmware to abandon a broken test and discard what is left."""
+        time.sleep(DEVICE_IDLE_TIMEOUT + 0.5)
+        while self.link.read(4096, 0.1):
+            pass
+        self.pending.clear()
+
+    def close(self):
+        self.link.close()
+        if self.process is not None:
+            self.process.terminate()
+            self.process.wait()
+
+
+def percentile(sorted_values, percent):
+    index = max(0, -(-len(sorted_values) * percent // 100) - 1)
+    return sorted_values[index]
+
+
+def per_byte(value, size):
+    return f"{value / size:.1f}" if value is not None and size else ""
+
+
+def run_echo(target, info, count, size):
+    message = bytes(range(size))
+    rtts = []
+    cpu_start = target.cpu_ns()
+    target.command(f"ECHO {count * size}", "READY")
+    for _ in range(count):
+        start = time.perf_counter_ns()
+        target.link.write(message)
+        if target.read_exact(size) != message:
+            raise RuntimeError("echo mismatch")
+        rtts.append((time.perf_counter_ns() - start) / 1000)
+    result = target.done()
+    return summarise(info, "echo", count * size, sum(rtts) / 1e6, result, cpu_start, target, rtts)
+
+
+def run_rx(target, info, size):
+    payload = bytes(i & 0xFF for i in range(size))
+    cpu_start = target.cpu_ns()
+    target.command(f"RX {size}", "READY")
+    start = time.perf_counter()
+    for offset in range(0, size, 4096):
+        target.link.write(payload[offset : offset + 4096])
+    result = target.done()
+    return summarise(info, "rx", size, time.perf_counter() - start, result, cpu_start, target)
+
+
+def run_tx(target, info, size):
+    cpu_start = target.cpu_ns()
+    target.command(f"TX {size}", "READY")
+    start = time.perf_counter()
+    data = target.read_exact(size)
+    elapsed = time.perf_counter() - start
+    if data != bytes(i & 0xFF for i in range(size)):
+        raise RuntimeError("TX pattern mismatch")
+    result = target.done()
+    return summarise(info, "tx", size, elapsed, result, cpu_start, target)
+
+
+def summarise(info, test, size, seconds, result, cpu_start, target, rtts=None):
+    cpu_end = target.cpu_ns()
+    cyc_per_sec = int(info.get("cyc_per_sec", 0))
+    # native_sim runs in zero simulated time; its cycle counts say nothing about CPU cost
+    dev_cycles = result["busy_cyc"] if target.process is None and cyc_per_sec else None
+    host_ns = cpu_end - cpu_start if cpu_start is not None else None
+
+    latency = ["", "", "", ""]
+    if rtts:
+        rtts.sort()
+        latency = [f"{percentile(rtts, p):.0f}" for p in (50, 90, 99)] + [f"{rtts[-1]:.0f}"]
+
+    return ",".join(
+        [
+            info.get("mode", "?"),
+            test,
+            str(size),
+            f"{seconds:.3f}",
+            f"{size / 1024 / max(seconds, 1e-9):.1f}",
+            *latency,
+            per_byte(dev_cycles, size),
+            per_byte(host_ns, size),
+            str(size - result["bytes"] + result["dropped"]),
+        ]
+    )
+
+
+def bench(target, args):
+    reply = target.command("INFO", "INFO")
+    info = dict(f.split("=", 1) for f in reply.split()[1:])
+    print(f"# {reply}", file=sys.stderr)
+
+    tests = (
+        ("echo", lambda: run_echo(target, info, args.count, args.size)),
+        ("rx", lambda: run_rx(target, info, args.bytes)),
+        ("tx", lambda: run_tx(target, info, args.bytes)),
+    )
+    for name, test in tests:
+        try:
+            print(test(), flush=True)
+        except (TimeoutError, RuntimeError) as error:
+            print(f"# {info.get('mode', '?')} {name} failed: {error}", file=sys.stderr)
+            target.resync()
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--exe", action="append", default=[], help="native_sim zephyr.exe")
+    parser.add_argument("--uart", default="uart_1", help="native_sim UART aliased bench-uart")
+    parser.add_argument("--port", help="serial port of a board instead of native_sim")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("--count", type=int, default=1000, help="echo round trips")
+    parser.add_argument("--size", type=int, default=16, help="echo message size")
+    parser.add_argument("--bytes", type=int, default=256 * 1024, help="RX and TX test size")
+    args = parser.parse_args()
+    if not args.exe and not args.port:
+        parser.error("give --exe or --port")
+
+    print(COLUMNS)
+    for exe in args.exe:
+        target = Target.spawn(exe, args.uart)
+        try:
+            bench(target, args)
+        finally:
+            target.close()
+
+    if args.port:
+        target = Target(SerialLink(args.port, args.baud))
+        try:
+            bench(target, args)
+        finally:
+            target.close()
+
+
+if __name__ == "__main__":
+    main()